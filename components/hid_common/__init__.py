@@ -0,0 +1,4 @@
+# Code shared by hid_composite, hid_keyboard and hid_mouse, which load it
+# through AUTO_LOAD. It has no configuration of its own.
+
+CODEOWNERS = ["@AntorFr"]
@@ -0,0 +1,342 @@
+// Generated by scripts/gen_keymaps.py - do not edit.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace hid_common {
+
+// Minimal perfect hash over 227 HID Keyboard usage page names.
+static const uint16_t KEY_NAME_COUNT = 227;
+static const uint16_t KEY_NAME_BUCKETS = 114;
+
+static const uint16_t KEY_NAME_SEEDS[KEY_NAME_BUCKETS] = {
+    3, 15, 5, 3, 0, 0, 6, 4, 3, 0, 11, 0,
+    0, 1, 9, 6, 2, 2, 12, 2, 1, 8, 5, 0,
+    0, 7, 1, 33, 8, 0, 1, 11, 1, 34, 0, 2,
+    3, 8, 1, 6, 2, 5, 8, 7, 1, 5, 7, 14,
+    18, 9, 7, 3, 3, 29, 2, 3, 10, 8, 32, 0,
+    23, 16, 22, 0, 1, 2, 21, 24, 7, 10, 1, 1,
+    2, 6, 1, 10, 5, 7, 0, 0, 13, 6, 1, 1,
+    32, 8, 12, 19, 34, 23, 1, 1, 119, 123, 34, 21,
+    16, 0, 1, 30, 8, 0, 54, 15, 49, 30, 5, 13,
+    0, 45, 5, 3, 31, 4,
+};
+
+static const char KEY_NAME_BLOB[] =
+    "NUM_LOCKKP_CARETKP_LEFT_PARENKP_5RIGHTSHIFT"
+    "ALTERNATE_ERASEPAGEUPKP_ATDELSTOPCANCEL"
+    "F21INTERNATIONAL1RIGHT_CTRLLEFT_BRACKETF18KP_MULTIPLY"
+    "LEFT_BRACEKP_DKP_COLONKP_MEM_ADDEQUALCOPY"
+    "RIGHT_BRACECUTKP_SUBTRACTFINDKP_SLASHLSHIFT"
+    "LANG4INTERNATIONAL2ESCLEFT_ALTKP_AF8"
+    "KP_LEFT_BRACEKP_3PAGE_DOWNAPPLICATIONDECIMAL_SEPARATORQUOTE"
+    "CMDKP_MINUSF12KP_RIGHT_PARENAGAINSLASH"
+    "LANG8KP_DECIMALDOWNENDF13INS"
+    "PAUSEINSERTKP_6MUTEGUIKP_BINARY"
+    "KP_DOUBLE_AMPERSANDRGUIHOMEKP_00PRINT_SCREENF11"
+    "LOCKING_NUM_LOCKLOCKING_CAPS_LOCKKP_ADDRIGHT_BRACKETKP_HEXADECIMALF15"
+    "PAGEDOWNINTL_BACKSLASHRALTKP_FKP_000F3"
+    "BKSPINTERNATIONAL7SEMICOLONINTERNATIONAL9DOWN_ARROWKP_7"
+    "RETURN2KP_COMMAF14RIGHT_SHIFTKP_MEM_SUBTRACTKEYBOARD_MENU"
+    "F4ENTERKP_MEM_MULTIPLYKP_MEM_CLEARLEFTESCAPE"
+    "F24F9MENUKP_1METAKP_MEM_DIVIDE"
+    "PASTEF10INTERNATIONAL3LEFT_SHIFTLALTCAPSLOCK"
+    "SCROLL_LOCKKP_PERCENTCONTEXT_MENUKP_TABOPERINTERNATIONAL5"
+    "F1UNDOBACKSLASHLANG5LANG7DOT"
+    "KP_MEM_RECALLPERIODINTERNATIONAL6PAGE_UPSCROLLLOCKKP_8"
+    "VOLUME_UPRIGHT_ALTALTGRF7PRTSCVOLUME_DOWN"
+    "F19KP_BLANG6F16CLEAR_AGAINKP_BACKSPACE"
+    "KP_2KP_PLUSOUTKP_MEM_STOREF23KP_ASTERISK"
+    "RIGHT_GUILANG9F17KP_EXCLAMATIONCAPS_LOCKKP_OCTAL"
+    "F5F22KP_DOTCLEARSELECTTHOUSANDS_SEPARATOR"
+    "PRIORKP_XORKP_9CRSELKP_DIVIDERIGHT_ARROW"
+    "KP_PIPESEPARATORLANG2KP_CLEARKP_CBACKSPACE"
+    "KP_EQUALRSHIFTCURRENCY_UNITSYSREQKP_LESSPOWER"
+    "LANG3PRINTSCREENATTENTIONALTINTERNATIONAL4KP_PLUS_MINUS"
+    "KP_RIGHT_BRACETABF2MINUSKP_DECIMAL_POINTBREAK"
+    "INTERNATIONAL8PGUPKP_EQUAL_SIGNSPACEEXECUTELEFT_GUI"
+    "CURRENCY_SUBUNITKP_4WINLGUIF6F20"
+    "COMMAKP_0CTRLKP_CLEAR_ENTRYKP_HASHHELP"
+    "KP_SPACENUMLOCKKP_DOUBLE_PIPELOCKING_SCROLL_LOCKRCTRLKP_AMPERSAND"
+    "KP_GREATERAPOSTROPHELANG1PGDNEXSELGRAVE"
+    "DELETERETURNUP_ARROWLEFT_ARROWKP_ENTERLCTRL"
+    "KP_ENON_US_HASHUPNON_US_BACKSLASHLEFT_CTRL";
+
+struct KeyNameEntry {
+  uint16_t offset;
+  uint8_t length;
+  uint8_t usage;
+};
+
+static const KeyNameEntry KEY_NAME_ENTRIES[KEY_NAME_COUNT] = {
+    {0, 8, 0x53},  // NUM_LOCK
+    {8, 8, 0xC3},  // KP_CARET
+    {16, 13, 0xB6},  // KP_LEFT_PAREN
+    {29, 4, 0x5D},  // KP_5
+    {33, 5, 0x4F},  // RIGHT
+    {38, 5, 0xE1},  // SHIFT
+    {43, 15, 0x99},  // ALTERNATE_ERASE
+    {58, 6, 0x4B},  // PAGEUP
+    {64, 5, 0xCE},  // KP_AT
+    {69, 3, 0x4C},  // DEL
+    {72, 4, 0x78},  // STOP
+    {76, 6, 0x9B},  // CANCEL
+    {82, 3, 0x70},  // F21
+    {85, 14, 0x87},  // INTERNATIONAL1
+    {99, 10, 0xE4},  // RIGHT_CTRL
+    {109, 12, 0x2F},  // LEFT_BRACKET
+    {121, 3, 0x6D},  // F18
+    {124, 11, 0x55},  // KP_MULTIPLY
+    {135, 10, 0x2F},  // LEFT_BRACE
+    {145, 4, 0xBF},  // KP_D
+    {149, 8, 0xCB},  // KP_COLON
+    {157, 10, 0xD3},  // KP_MEM_ADD
+    {167, 5, 0x2E},  // EQUAL
+    {172, 4, 0x7C},  // COPY
+    {176, 11, 0x30},  // RIGHT_BRACE
+    {187, 3, 0x7B},  // CUT
+    {190, 11, 0x56},  // KP_SUBTRACT
+    {201, 4, 0x7E},  // FIND
+    {205, 8, 0x54},  // KP_SLASH
+    {213, 6, 0xE1},  // LSHIFT
+    {219, 5, 0x93},  // LANG4
+    {224, 14, 0x88},  // INTERNATIONAL2
+    {238, 3, 0x29},  // ESC
+    {241, 8, 0xE2},  // LEFT_ALT
+    {249, 4, 0xBC},  // KP_A
+    {253, 2, 0x41},  // F8
+    {255, 13, 0xB8},  // KP_LEFT_BRACE
+    {268, 4, 0x5B},  // KP_3
+    {272, 9, 0x4E},  // PAGE_DOWN
+    {281, 11, 0x65},  // APPLICATION
+    {292, 17, 0xB3},  // DECIMAL_SEPARATOR
+    {309, 5, 0x34},  // QUOTE
+    {314, 3, 0xE3},  // CMD
+    {317, 8, 0x56},  // KP_MINUS
+    {325, 3, 0x45},  // F12
+    {328, 14, 0xB7},  // KP_RIGHT_PAREN
+    {342, 5, 0x79},  // AGAIN
+    {347, 5, 0x38},  // SLASH
+    {352, 5, 0x97},  // LANG8
+    {357, 10, 0xDC},  // KP_DECIMAL
+    {367, 4, 0x51},  // DOWN
+    {371, 3, 0x4D},  // END
+    {374, 3, 0x68},  // F13
+    {377, 3, 0x49},  // INS
+    {380, 5, 0x48},  // PAUSE
+    {385, 6, 0x49},  // INSERT
+    {391, 4, 0x5E},  // KP_6
+    {395, 4, 0x7F},  // MUTE
+    {399, 3, 0xE3},  // GUI
+    {402, 9, 0xDA},  // KP_BINARY
+    {411, 19, 0xC8},  // KP_DOUBLE_AMPERSAND
+    {430, 4, 0xE7},  // RGUI
+    {434, 4, 0x4A},  // HOME
+    {438, 5, 0xB0},  // KP_00
+    {443, 12, 0x46},  // PRINT_SCREEN
+    {455, 3, 0x44},  // F11
+    {458, 16, 0x83},  // LOCKING_NUM_LOCK
+    {474, 17, 0x82},  // LOCKING_CAPS_LOCK
+    {491, 6, 0x57},  // KP_ADD
+    {497, 13, 0x30},  // RIGHT_BRACKET
+    {510, 14, 0xDD},  // KP_HEXADECIMAL
+    {524, 3, 0x6A},  // F15
+    {527, 8, 0x4E},  // PAGEDOWN
+    {535, 14, 0x64},  // INTL_BACKSLASH
+    {549, 4, 0xE6},  // RALT
+    {553, 4, 0xC1},  // KP_F
+    {557, 6, 0xB1},  // KP_000
+    {563, 2, 0x3C},  // F3
+    {565, 4, 0x2A},  // BKSP
+    {569, 14, 0x8D},  // INTERNATIONAL7
+    {583, 9, 0x33},  // SEMICOLON
+    {592, 14, 0x8F},  // INTERNATIONAL9
+    {606, 10, 0x51},  // DOWN_ARROW
+    {616, 4, 0x5F},  // KP_7
+    {620, 7, 0x9E},  // RETURN2
+    {627, 8, 0x85},  // KP_COMMA
+    {635, 3, 0x69},  // F14
+    {638, 11, 0xE5},  // RIGHT_SHIFT
+    {649, 15, 0xD4},  // KP_MEM_SUBTRACT
+    {664, 13, 0x76},  // KEYBOARD_MENU
+    {677, 2, 0x3D},  // F4
+    {679, 5, 0x28},  // ENTER
+    {684, 15, 0xD5},  // KP_MEM_MULTIPLY
+    {699, 12, 0xD2},  // KP_MEM_CLEAR
+    {711, 4, 0x50},  // LEFT
+    {715, 6, 0x29},  // ESCAPE
+    {721, 3, 0x73},  // F24
+    {724, 2, 0x42},  // F9
+    {726, 4, 0x65},  // MENU
+    {730, 4, 0x59},  // KP_1
+    {734, 4, 0xE3},  // META
+    {738, 13, 0xD6},  // KP_MEM_DIVIDE
+    {751, 5, 0x7D},  // PASTE
+    {756, 3, 0x43},  // F10
+    {759, 14, 0x89},  // INTERNATIONAL3
+    {773, 10, 0xE1},  // LEFT_SHIFT
+    {783, 4, 0xE2},  // LALT
+    {787, 8, 0x39},  // CAPSLOCK
+    {795, 11, 0x47},  // SCROLL_LOCK
+    {806, 10, 0xC4},  // KP_PERCENT
+    {816, 12, 0x65},  // CONTEXT_MENU
+    {828, 6, 0xBA},  // KP_TAB
+    {834, 4, 0xA1},  // OPER
+    {838, 14, 0x8B},  // INTERNATIONAL5
+    {852, 2, 0x3A},  // F1
+    {854, 4, 0x7A},  // UNDO
+    {858, 9, 0x31},  // BACKSLASH
+    {867, 5, 0x94},  // LANG5
+    {872, 5, 0x96},  // LANG7
+    {877, 3, 0x37},  // DOT
+    {880, 13, 0xD1},  // KP_MEM_RECALL
+    {893, 6, 0x37},  // PERIOD
+    {899, 14, 0x8C},  // INTERNATIONAL6
+    {913, 7, 0x4B},  // PAGE_UP
+    {920, 10, 0x47},  // SCROLLLOCK
+    {930, 4, 0x60},  // KP_8
+    {934, 9, 0x80},  // VOLUME_UP
+    {943, 9, 0xE6},  // RIGHT_ALT
+    {952, 5, 0xE6},  // ALTGR
+    {957, 2, 0x40},  // F7
+    {959, 5, 0x46},  // PRTSC
+    {964, 11, 0x81},  // VOLUME_DOWN
+    {975, 3, 0x6E},  // F19
+    {978, 4, 0xBD},  // KP_B
+    {982, 5, 0x95},  // LANG6
+    {987, 3, 0x6B},  // F16
+    {990, 11, 0xA2},  // CLEAR_AGAIN
+    {1001, 12, 0xBB},  // KP_BACKSPACE
+    {1013, 4, 0x5A},  // KP_2
+    {1017, 7, 0x57},  // KP_PLUS
+    {1024, 3, 0xA0},  // OUT
+    {1027, 12, 0xD0},  // KP_MEM_STORE
+    {1039, 3, 0x72},  // F23
+    {1042, 11, 0x55},  // KP_ASTERISK
+    {1053, 9, 0xE7},  // RIGHT_GUI
+    {1062, 5, 0x98},  // LANG9
+    {1067, 3, 0x6C},  // F17
+    {1070, 14, 0xCF},  // KP_EXCLAMATION
+    {1084, 9, 0x39},  // CAPS_LOCK
+    {1093, 8, 0xDB},  // KP_OCTAL
+    {1101, 2, 0x3E},  // F5
+    {1103, 3, 0x71},  // F22
+    {1106, 6, 0x63},  // KP_DOT
+    {1112, 5, 0x9C},  // CLEAR
+    {1117, 6, 0x77},  // SELECT
+    {1123, 19, 0xB2},  // THOUSANDS_SEPARATOR
+    {1142, 5, 0x9D},  // PRIOR
+    {1147, 6, 0xC2},  // KP_XOR
+    {1153, 4, 0x61},  // KP_9
+    {1157, 5, 0xA3},  // CRSEL
+    {1162, 9, 0x54},  // KP_DIVIDE
+    {1171, 11, 0x4F},  // RIGHT_ARROW
+    {1182, 7, 0xC9},  // KP_PIPE
+    {1189, 9, 0x9F},  // SEPARATOR
+    {1198, 5, 0x91},  // LANG2
+    {1203, 8, 0xD8},  // KP_CLEAR
+    {1211, 4, 0xBE},  // KP_C
+    {1215, 9, 0x2A},  // BACKSPACE
+    {1224, 8, 0x67},  // KP_EQUAL
+    {1232, 6, 0xE5},  // RSHIFT
+    {1238, 13, 0xB4},  // CURRENCY_UNIT
+    {1251, 6, 0x9A},  // SYSREQ
+    {1257, 7, 0xC5},  // KP_LESS
+    {1264, 5, 0x66},  // POWER
+    {1269, 5, 0x92},  // LANG3
+    {1274, 11, 0x46},  // PRINTSCREEN
+    {1285, 9, 0x9A},  // ATTENTION
+    {1294, 3, 0xE2},  // ALT
+    {1297, 14, 0x8A},  // INTERNATIONAL4
+    {1311, 13, 0xD7},  // KP_PLUS_MINUS
+    {1324, 14, 0xB9},  // KP_RIGHT_BRACE
+    {1338, 3, 0x2B},  // TAB
+    {1341, 2, 0x3B},  // F2
+    {1343, 5, 0x2D},  // MINUS
+    {1348, 16, 0x63},  // KP_DECIMAL_POINT
+    {1364, 5, 0x48},  // BREAK
+    {1369, 14, 0x8E},  // INTERNATIONAL8
+    {1383, 4, 0x4B},  // PGUP
+    {1387, 13, 0x86},  // KP_EQUAL_SIGN
+    {1400, 5, 0x2C},  // SPACE
+    {1405, 7, 0x74},  // EXECUTE
+    {1412, 8, 0xE3},  // LEFT_GUI
+    {1420, 16, 0xB5},  // CURRENCY_SUBUNIT
+    {1436, 4, 0x5C},  // KP_4
+    {1440, 3, 0xE3},  // WIN
+    {1443, 4, 0xE3},  // LGUI
+    {1447, 2, 0x3F},  // F6
+    {1449, 3, 0x6F},  // F20
+    {1452, 5, 0x36},  // COMMA
+    {1457, 4, 0x62},  // KP_0
+    {1461, 4, 0xE0},  // CTRL
+    {1465, 14, 0xD9},  // KP_CLEAR_ENTRY
+    {1479, 7, 0xCC},  // KP_HASH
+    {1486, 4, 0x75},  // HELP
+    {1490, 8, 0xCD},  // KP_SPACE
+    {1498, 7, 0x53},  // NUMLOCK
+    {1505, 14, 0xCA},  // KP_DOUBLE_PIPE
+    {1519, 19, 0x84},  // LOCKING_SCROLL_LOCK
+    {1538, 5, 0xE4},  // RCTRL
+    {1543, 12, 0xC7},  // KP_AMPERSAND
+    {1555, 10, 0xC6},  // KP_GREATER
+    {1565, 10, 0x34},  // APOSTROPHE
+    {1575, 5, 0x90},  // LANG1
+    {1580, 4, 0x4E},  // PGDN
+    {1584, 5, 0xA4},  // EXSEL
+    {1589, 5, 0x35},  // GRAVE
+    {1594, 6, 0x4C},  // DELETE
+    {1600, 6, 0x28},  // RETURN
+    {1606, 8, 0x52},  // UP_ARROW
+    {1614, 10, 0x50},  // LEFT_ARROW
+    {1624, 8, 0x58},  // KP_ENTER
+    {1632, 5, 0xE0},  // LCTRL
+    {1637, 4, 0xC0},  // KP_E
+    {1641, 11, 0x32},  // NON_US_HASH
+    {1652, 2, 0x52},  // UP
+    {1654, 16, 0x64},  // NON_US_BACKSLASH
+    {1670, 9, 0xE0},  // LEFT_CTRL
+};
+
+static inline uint8_t key_name_upper(char c) {
+  return (c >= 'a' && c <= 'z') ? c - ('a' - 'A') : c;
+}
+
+static inline uint32_t key_name_hash(const char *name, size_t length) {
+  uint32_t h = 0x811C9DC5u;
+  for (size_t i = 0; i < length; i++) {
+    h ^= key_name_upper(name[i]);
+    h *= 0x01000193u;
+  }
+  return h;
+}
+
+static inline uint32_t key_name_mix(uint32_t h, uint32_t seed) {
+  h ^= seed;
+  h ^= h >> 16;
+  h *= 0x85EBCA6Bu;
+  h ^= h >> 13;
+  h *= 0xC2B2AE35u;
+  h ^= h >> 16;
+  return h;
+}
+
+// Returns the HID usage for a key name (case-insensitive), or 0 if unknown.
+static inline uint8_t lookup_key_name(const char *name, size_t length) {
+  uint32_t h = key_name_hash(name, length);
+  const KeyNameEntry &entry =
+      KEY_NAME_ENTRIES[key_name_mix(h, KEY_NAME_SEEDS[h % KEY_NAME_BUCKETS]) % KEY_NAME_COUNT];
+  if (entry.length != length)
+    return 0;
+  const char *candidate = KEY_NAME_BLOB + entry.offset;
+  for (size_t i = 0; i < length; i++) {
+    if (key_name_upper(name[i]) != candidate[i])
+      return 0;
+  }
+  return entry.usage;
+}
+
+}  // namespace hid_common
+}  // namespace esphome
@@ -0,0 +1,498 @@
+# Generated by scripts/gen_keymaps.py - do not edit.
+
+# Key name -> HID usage (Keyboard/Keypad page)
+KEY_NAMES = {
+    "ENTER": 0x28,
+    "RETURN": 0x28,
+    "ESC": 0x29,
+    "ESCAPE": 0x29,
+    "BACKSPACE": 0x2A,
+    "BKSP": 0x2A,
+    "TAB": 0x2B,
+    "SPACE": 0x2C,
+    "MINUS": 0x2D,
+    "EQUAL": 0x2E,
+    "LEFT_BRACE": 0x2F,
+    "LEFT_BRACKET": 0x2F,
+    "RIGHT_BRACE": 0x30,
+    "RIGHT_BRACKET": 0x30,
+    "BACKSLASH": 0x31,
+    "NON_US_HASH": 0x32,
+    "SEMICOLON": 0x33,
+    "APOSTROPHE": 0x34,
+    "QUOTE": 0x34,
+    "GRAVE": 0x35,
+    "COMMA": 0x36,
+    "PERIOD": 0x37,
+    "DOT": 0x37,
+    "SLASH": 0x38,
+    "CAPS_LOCK": 0x39,
+    "CAPSLOCK": 0x39,
+    "F1": 0x3A,
+    "F2": 0x3B,
+    "F3": 0x3C,
+    "F4": 0x3D,
+    "F5": 0x3E,
+    "F6": 0x3F,
+    "F7": 0x40,
+    "F8": 0x41,
+    "F9": 0x42,
+    "F10": 0x43,
+    "F11": 0x44,
+    "F12": 0x45,
+    "PRINT_SCREEN": 0x46,
+    "PRINTSCREEN": 0x46,
+    "PRTSC": 0x46,
+    "SCROLL_LOCK": 0x47,
+    "SCROLLLOCK": 0x47,
+    "PAUSE": 0x48,
+    "BREAK": 0x48,
+    "INSERT": 0x49,
+    "INS": 0x49,
+    "HOME": 0x4A,
+    "PAGEUP": 0x4B,
+    "PAGE_UP": 0x4B,
+    "PGUP": 0x4B,
+    "DELETE": 0x4C,
+    "DEL": 0x4C,
+    "END": 0x4D,
+    "PAGEDOWN": 0x4E,
+    "PAGE_DOWN": 0x4E,
+    "PGDN": 0x4E,
+    "RIGHT": 0x4F,
+    "RIGHT_ARROW": 0x4F,
+    "LEFT": 0x50,
+    "LEFT_ARROW": 0x50,
+    "DOWN": 0x51,
+    "DOWN_ARROW": 0x51,
+    "UP": 0x52,
+    "UP_ARROW": 0x52,
+    "NUM_LOCK": 0x53,
+    "NUMLOCK": 0x53,
+    "KP_SLASH": 0x54,
+    "KP_DIVIDE": 0x54,
+    "KP_ASTERISK": 0x55,
+    "KP_MULTIPLY": 0x55,
+    "KP_MINUS": 0x56,
+    "KP_SUBTRACT": 0x56,
+    "KP_PLUS": 0x57,
+    "KP_ADD": 0x57,
+    "KP_ENTER": 0x58,
+    "KP_1": 0x59,
+    "KP_2": 0x5A,
+    "KP_3": 0x5B,
+    "KP_4": 0x5C,
+    "KP_5": 0x5D,
+    "KP_6": 0x5E,
+    "KP_7": 0x5F,
+    "KP_8": 0x60,
+    "KP_9": 0x61,
+    "KP_0": 0x62,
+    "KP_DOT": 0x63,
+    "KP_DECIMAL_POINT": 0x63,
+    "NON_US_BACKSLASH": 0x64,
+    "INTL_BACKSLASH": 0x64,
+    "MENU": 0x65,
+    "APPLICATION": 0x65,
+    "CONTEXT_MENU": 0x65,
+    "POWER": 0x66,
+    "KP_EQUAL": 0x67,
+    "F13": 0x68,
+    "F14": 0x69,
+    "F15": 0x6A,
+    "F16": 0x6B,
+    "F17": 0x6C,
+    "F18": 0x6D,
+    "F19": 0x6E,
+    "F20": 0x6F,
+    "F21": 0x70,
+    "F22": 0x71,
+    "F23": 0x72,
+    "F24": 0x73,
+    "EXECUTE": 0x74,
+    "HELP": 0x75,
+    "KEYBOARD_MENU": 0x76,
+    "SELECT": 0x77,
+    "STOP": 0x78,
+    "AGAIN": 0x79,
+    "UNDO": 0x7A,
+    "CUT": 0x7B,
+    "COPY": 0x7C,
+    "PASTE": 0x7D,
+    "FIND": 0x7E,
+    "MUTE": 0x7F,
+    "VOLUME_UP": 0x80,
+    "VOLUME_DOWN": 0x81,
+    "LOCKING_CAPS_LOCK": 0x82,
+    "LOCKING_NUM_LOCK": 0x83,
+    "LOCKING_SCROLL_LOCK": 0x84,
+    "KP_COMMA": 0x85,
+    "KP_EQUAL_SIGN": 0x86,
+    "INTERNATIONAL1": 0x87,
+    "INTERNATIONAL2": 0x88,
+    "INTERNATIONAL3": 0x89,
+    "INTERNATIONAL4": 0x8A,
+    "INTERNATIONAL5": 0x8B,
+    "INTERNATIONAL6": 0x8C,
+    "INTERNATIONAL7": 0x8D,
+    "INTERNATIONAL8": 0x8E,
+    "INTERNATIONAL9": 0x8F,
+    "LANG1": 0x90,
+    "LANG2": 0x91,
+    "LANG3": 0x92,
+    "LANG4": 0x93,
+    "LANG5": 0x94,
+    "LANG6": 0x95,
+    "LANG7": 0x96,
+    "LANG8": 0x97,
+    "LANG9": 0x98,
+    "ALTERNATE_ERASE": 0x99,
+    "SYSREQ": 0x9A,
+    "ATTENTION": 0x9A,
+    "CANCEL": 0x9B,
+    "CLEAR": 0x9C,
+    "PRIOR": 0x9D,
+    "RETURN2": 0x9E,
+    "SEPARATOR": 0x9F,
+    "OUT": 0xA0,
+    "OPER": 0xA1,
+    "CLEAR_AGAIN": 0xA2,
+    "CRSEL": 0xA3,
+    "EXSEL": 0xA4,
+    "KP_00": 0xB0,
+    "KP_000": 0xB1,
+    "THOUSANDS_SEPARATOR": 0xB2,
+    "DECIMAL_SEPARATOR": 0xB3,
+    "CURRENCY_UNIT": 0xB4,
+    "CURRENCY_SUBUNIT": 0xB5,
+    "KP_LEFT_PAREN": 0xB6,
+    "KP_RIGHT_PAREN": 0xB7,
+    "KP_LEFT_BRACE": 0xB8,
+    "KP_RIGHT_BRACE": 0xB9,
+    "KP_TAB": 0xBA,
+    "KP_BACKSPACE": 0xBB,
+    "KP_A": 0xBC,
+    "KP_B": 0xBD,
+    "KP_C": 0xBE,
+    "KP_D": 0xBF,
+    "KP_E": 0xC0,
+    "KP_F": 0xC1,
+    "KP_XOR": 0xC2,
+    "KP_CARET": 0xC3,
+    "KP_PERCENT": 0xC4,
+    "KP_LESS": 0xC5,
+    "KP_GREATER": 0xC6,
+    "KP_AMPERSAND": 0xC7,
+    "KP_DOUBLE_AMPERSAND": 0xC8,
+    "KP_PIPE": 0xC9,
+    "KP_DOUBLE_PIPE": 0xCA,
+    "KP_COLON": 0xCB,
+    "KP_HASH": 0xCC,
+    "KP_SPACE": 0xCD,
+    "KP_AT": 0xCE,
+    "KP_EXCLAMATION": 0xCF,
+    "KP_MEM_STORE": 0xD0,
+    "KP_MEM_RECALL": 0xD1,
+    "KP_MEM_CLEAR": 0xD2,
+    "KP_MEM_ADD": 0xD3,
+    "KP_MEM_SUBTRACT": 0xD4,
+    "KP_MEM_MULTIPLY": 0xD5,
+    "KP_MEM_DIVIDE": 0xD6,
+    "KP_PLUS_MINUS": 0xD7,
+    "KP_CLEAR": 0xD8,
+    "KP_CLEAR_ENTRY": 0xD9,
+    "KP_BINARY": 0xDA,
+    "KP_OCTAL": 0xDB,
+    "KP_DECIMAL": 0xDC,
+    "KP_HEXADECIMAL": 0xDD,
+    "LEFT_CTRL": 0xE0,
+    "LCTRL": 0xE0,
+    "CTRL": 0xE0,
+    "LEFT_SHIFT": 0xE1,
+    "LSHIFT": 0xE1,
+    "SHIFT": 0xE1,
+    "LEFT_ALT": 0xE2,
+    "LALT": 0xE2,
+    "ALT": 0xE2,
+    "LEFT_GUI": 0xE3,
+    "LGUI": 0xE3,
+    "GUI": 0xE3,
+    "WIN": 0xE3,
+    "CMD": 0xE3,
+    "META": 0xE3,
+    "RIGHT_CTRL": 0xE4,
+    "RCTRL": 0xE4,
+    "RIGHT_SHIFT": 0xE5,
+    "RSHIFT": 0xE5,
+    "RIGHT_ALT": 0xE6,
+    "RALT": 0xE6,
+    "ALTGR": 0xE6,
+    "RIGHT_GUI": 0xE7,
+    "RGUI": 0xE7,
+}
+
+# Layout -> character -> (HID usage, implied modifier)
+LAYOUT_CHARS = {
+    "QWERTY_US": {
+        'a': (0x04, 0x00),
+        'A': (0x04, 0x02),
+        'b': (0x05, 0x00),
+        'B': (0x05, 0x02),
+        'c': (0x06, 0x00),
+        'C': (0x06, 0x02),
+        'd': (0x07, 0x00),
+        'D': (0x07, 0x02),
+        'e': (0x08, 0x00),
+        'E': (0x08, 0x02),
+        'f': (0x09, 0x00),
+        'F': (0x09, 0x02),
+        'g': (0x0A, 0x00),
+        'G': (0x0A, 0x02),
+        'h': (0x0B, 0x00),
+        'H': (0x0B, 0x02),
+        'i': (0x0C, 0x00),
+        'I': (0x0C, 0x02),
+        'j': (0x0D, 0x00),
+        'J': (0x0D, 0x02),
+        'k': (0x0E, 0x00),
+        'K': (0x0E, 0x02),
+        'l': (0x0F, 0x00),
+        'L': (0x0F, 0x02),
+        'm': (0x10, 0x00),
+        'M': (0x10, 0x02),
+        'n': (0x11, 0x00),
+        'N': (0x11, 0x02),
+        'o': (0x12, 0x00),
+        'O': (0x12, 0x02),
+        'p': (0x13, 0x00),
+        'P': (0x13, 0x02),
+        'q': (0x14, 0x00),
+        'Q': (0x14, 0x02),
+        'r': (0x15, 0x00),
+        'R': (0x15, 0x02),
+        's': (0x16, 0x00),
+        'S': (0x16, 0x02),
+        't': (0x17, 0x00),
+        'T': (0x17, 0x02),
+        'u': (0x18, 0x00),
+        'U': (0x18, 0x02),
+        'v': (0x19, 0x00),
+        'V': (0x19, 0x02),
+        'w': (0x1A, 0x00),
+        'W': (0x1A, 0x02),
+        'x': (0x1B, 0x00),
+        'X': (0x1B, 0x02),
+        'y': (0x1C, 0x00),
+        'Y': (0x1C, 0x02),
+        'z': (0x1D, 0x00),
+        'Z': (0x1D, 0x02),
+        '1': (0x1E, 0x00),
+        '2': (0x1F, 0x00),
+        '3': (0x20, 0x00),
+        '4': (0x21, 0x00),
+        '5': (0x22, 0x00),
+        '6': (0x23, 0x00),
+        '7': (0x24, 0x00),
+        '8': (0x25, 0x00),
+        '9': (0x26, 0x00),
+        '0': (0x27, 0x00),
+        ' ': (0x2C, 0x00),
+        '\n': (0x28, 0x00),
+        '\t': (0x2B, 0x00),
+        '-': (0x2D, 0x00),
+        '=': (0x2E, 0x00),
+        '[': (0x2F, 0x00),
+        ']': (0x30, 0x00),
+        '\\': (0x31, 0x00),
+        ';': (0x33, 0x00),
+        "'": (0x34, 0x00),
+        '`': (0x35, 0x00),
+        ',': (0x36, 0x00),
+        '.': (0x37, 0x00),
+        '/': (0x38, 0x00),
+        '!': (0x1E, 0x02),
+        '@': (0x1F, 0x02),
+        '#': (0x20, 0x02),
+        '$': (0x21, 0x02),
+        '%': (0x22, 0x02),
+        '^': (0x23, 0x02),
+        '&': (0x24, 0x02),
+        '*': (0x25, 0x02),
+        '(': (0x26, 0x02),
+        ')': (0x27, 0x02),
+        '_': (0x2D, 0x02),
+        '+': (0x2E, 0x02),
+        '{': (0x2F, 0x02),
+        '}': (0x30, 0x02),
+        '|': (0x31, 0x02),
+        ':': (0x33, 0x02),
+        '"': (0x34, 0x02),
+        '~': (0x35, 0x02),
+        '<': (0x36, 0x02),
+        '>': (0x37, 0x02),
+        '?': (0x38, 0x02),
+    },
+    "AZERTY_FR": {
+        'a': (0x14, 0x00),
+        'A': (0x14, 0x02),
+        'b': (0x05, 0x00),
+        'B': (0x05, 0x02),
+        'c': (0x06, 0x00),
+        'C': (0x06, 0x02),
+        'd': (0x07, 0x00),
+        'D': (0x07, 0x02),
+        'e': (0x08, 0x00),
+        'E': (0x08, 0x02),
+        'f': (0x09, 0x00),
+        'F': (0x09, 0x02),
+        'g': (0x0A, 0x00),
+        'G': (0x0A, 0x02),
+        'h': (0x0B, 0x00),
+        'H': (0x0B, 0x02),
+        'i': (0x0C, 0x00),
+        'I': (0x0C, 0x02),
+        'j': (0x0D, 0x00),
+        'J': (0x0D, 0x02),
+        'k': (0x0E, 0x00),
+        'K': (0x0E, 0x02),
+        'l': (0x0F, 0x00),
+        'L': (0x0F, 0x02),
+        'm': (0x33, 0x00),
+        'M': (0x33, 0x02),
+        'n': (0x11, 0x00),
+        'N': (0x11, 0x02),
+        'o': (0x12, 0x00),
+        'O': (0x12, 0x02),
+        'p': (0x13, 0x00),
+        'P': (0x13, 0x02),
+        'q': (0x04, 0x00),
+        'Q': (0x04, 0x02),
+        'r': (0x15, 0x00),
+        'R': (0x15, 0x02),
+        's': (0x16, 0x00),
+        'S': (0x16, 0x02),
+        't': (0x17, 0x00),
+        'T': (0x17, 0x02),
+        'u': (0x18, 0x00),
+        'U': (0x18, 0x02),
+        'v': (0x19, 0x00),
+        'V': (0x19, 0x02),
+        'w': (0x1D, 0x00),
+        'W': (0x1D, 0x02),
+        'x': (0x1B, 0x00),
+        'X': (0x1B, 0x02),
+        'y': (0x1C, 0x00),
+        'Y': (0x1C, 0x02),
+        'z': (0x1A, 0x00),
+        'Z': (0x1A, 0x02),
+        '1': (0x1E, 0x02),
+        '2': (0x1F, 0x02),
+        '3': (0x20, 0x02),
+        '4': (0x21, 0x02),
+        '5': (0x22, 0x02),
+        '6': (0x23, 0x02),
+        '7': (0x24, 0x02),
+        '8': (0x25, 0x02),
+        '9': (0x26, 0x02),
+        '0': (0x27, 0x02),
+        ' ': (0x2C, 0x00),
+        '\n': (0x28, 0x00),
+        '\t': (0x2B, 0x00),
+        '&': (0x1E, 0x00),
+        '-': (0x23, 0x00),
+        '_': (0x25, 0x00),
+        '.': (0x36, 0x02),
+        ',': (0x10, 0x00),
+        ';': (0x36, 0x00),
+        ':': (0x37, 0x00),
+        '!': (0x38, 0x00),
+        '?': (0x10, 0x02),
+        '/': (0x37, 0x02),
+        '*': (0x31, 0x00),
+        '(': (0x22, 0x00),
+        ')': (0x2D, 0x00),
+        '=': (0x2E, 0x00),
+        '+': (0x2E, 0x02),
+    },
+    "QWERTZ_DE": {
+        'a': (0x04, 0x00),
+        'A': (0x04, 0x02),
+        'b': (0x05, 0x00),
+        'B': (0x05, 0x02),
+        'c': (0x06, 0x00),
+        'C': (0x06, 0x02),
+        'd': (0x07, 0x00),
+        'D': (0x07, 0x02),
+        'e': (0x08, 0x00),
+        'E': (0x08, 0x02),
+        'f': (0x09, 0x00),
+        'F': (0x09, 0x02),
+        'g': (0x0A, 0x00),
+        'G': (0x0A, 0x02),
+        'h': (0x0B, 0x00),
+        'H': (0x0B, 0x02),
+        'i': (0x0C, 0x00),
+        'I': (0x0C, 0x02),
+        'j': (0x0D, 0x00),
+        'J': (0x0D, 0x02),
+        'k': (0x0E, 0x00),
+        'K': (0x0E, 0x02),
+        'l': (0x0F, 0x00),
+        'L': (0x0F, 0x02),
+        'm': (0x10, 0x00),
+        'M': (0x10, 0x02),
+        'n': (0x11, 0x00),
+        'N': (0x11, 0x02),
+        'o': (0x12, 0x00),
+        'O': (0x12, 0x02),
+        'p': (0x13, 0x00),
+        'P': (0x13, 0x02),
+        'q': (0x14, 0x00),
+        'Q': (0x14, 0x02),
+        'r': (0x15, 0x00),
+        'R': (0x15, 0x02),
+        's': (0x16, 0x00),
+        'S': (0x16, 0x02),
+        't': (0x17, 0x00),
+        'T': (0x17, 0x02),
+        'u': (0x18, 0x00),
+        'U': (0x18, 0x02),
+        'v': (0x19, 0x00),
+        'V': (0x19, 0x02),
+        'w': (0x1A, 0x00),
+        'W': (0x1A, 0x02),
+        'x': (0x1B, 0x00),
+        'X': (0x1B, 0x02),
+        'y': (0x1D, 0x00),
+        'Y': (0x1D, 0x02),
+        'z': (0x1C, 0x00),
+        'Z': (0x1C, 0x02),
+        '1': (0x1E, 0x00),
+        '2': (0x1F, 0x00),
+        '3': (0x20, 0x00),
+        '4': (0x21, 0x00),
+        '5': (0x22, 0x00),
+        '6': (0x23, 0x00),
+        '7': (0x24, 0x00),
+        '8': (0x25, 0x00),
+        '9': (0x26, 0x00),
+        '0': (0x27, 0x00),
+        ' ': (0x2C, 0x00),
+        '\n': (0x28, 0x00),
+        '\t': (0x2B, 0x00),
+        '-': (0x38, 0x00),
+        '_': (0x38, 0x02),
+        '.': (0x37, 0x00),
+        ',': (0x36, 0x00),
+        ';': (0x36, 0x02),
+        ':': (0x37, 0x02),
+        '?': (0x2D, 0x02),
+        '!': (0x1E, 0x02),
+        '/': (0x24, 0x02),
+        '(': (0x25, 0x02),
+        ')': (0x26, 0x02),
+        '=': (0x27, 0x02),
+        '+': (0x30, 0x00),
+        '*': (0x30, 0x02),
+    },
+}
@@ -0,0 +1,80 @@
+#include "typing_model.h"
+
+#include <cmath>
+
+namespace esphome {
+namespace hid_common {
+
+// Standard normal quantiles at i / 64 (ends clamped to 0.25 / 64), 4.12 fixed point
+static const int16_t NORMAL_QUANTILES[65] = {
+    -10896, -8822, -7630, -6865, -6284, -5807, -5399, -5038,
+    -4712,  -4414, -4137, -3878, -3634, -3402, -3180, -2968,
+    -2763,  -2565, -2372, -2185, -2002, -1823, -1648, -1475,
+    -1305,  -1137, -972,  -807,  -644,  -482,  -321,  -160,
+    0,      160,   321,   482,   644,   807,   972,   1137,
+    1305,   1475,  1648,  1823,  2002,  2185,  2372,  2565,
+    2763,   2968,  3180,  3402,  3634,  3878,  4137,  4414,
+    4712,   5038,  5399,  5807,  6284,  6865,  7630,  8822,
+    10896,
+};
+
+// Touch-typing finger per HID usage 0x04-0x38 (letters, digits, Enter to '/'):
+// 0-3 left pinky to index, 4-7 right index to pinky, 8 thumb, 9 other
+enum Finger : uint8_t { THUMB = 8, OTHER = 9 };
+static const uint8_t USAGE_FINGERS[] = {
+    0, 3, 2, 2, 2, 3, 3, 4, 5, 4, 5, 6, 4, 4, 6, 7, 0, 3, 1, 3, 4, 3, 1, 1, 4, 0,  // a-z
+    0, 1, 2, 3, 3, 4, 4, 5, 6, 7,                                                  // 1-0
+    7, OTHER, 7, 0, THUMB,                                                         // Enter Esc Bksp Tab Space
+    7, 7, 7, 7, 7, 7, 7, 7, 0, 5, 6, 7,                                            // - = [ ] \ # ; ' ` , . /
+};
+
+static uint8_t usage_finger(uint8_t usage) {
+  if (usage >= 0x04 && usage < 0x04 + sizeof(USAGE_FINGERS)) return USAGE_FINGERS[usage - 0x04];
+  return OTHER;
+}
+
+// Digraph latency relative to speed, 8.8 fixed point
+enum Digraph : uint8_t { SAME_KEY, SAME_FINGER, SAME_HAND, OTHER_HAND, THUMB_KEY, UNKNOWN };
+static const uint16_t DIGRAPH_LATENCY[] = {
+    294,  // same key repeated
+    346,  // same finger, different key: the finger has to travel
+    256,  // same hand, different fingers
+    205,  // alternating hands overlap their movements
+    230,  // to or from the space bar
+    307,  // keys outside the touch-typing area
+};
+
+static Digraph classify(uint8_t from, uint8_t to) {
+  if (from == 0 || to == 0) return UNKNOWN;
+  if (from == to) return SAME_KEY;
+  uint8_t a = usage_finger(from), b = usage_finger(to);
+  if (a == OTHER || b == OTHER) return UNKNOWN;
+  if (a == THUMB || b == THUMB) return THUMB_KEY;
+  if (a == b) return SAME_FINGER;
+  return (a < 4) == (b < 4) ? SAME_HAND : OTHER_HAND;
+}
+
+void TypingModel::set_spread_(uint32_t speed_ms, uint32_t jitter_ms) {
+  float sigma = speed_ms > 0 ? (float) jitter_ms / speed_ms : 1.0f;
+  if (sigma > 1.0f) sigma = 1.0f;
+  for (uint8_t i = 0; i <= SPREAD_STEPS; i++) {
+    this->spread_[i] = (uint16_t) lroundf(expf(sigma * NORMAL_QUANTILES[i] / 4096.0f) * 256.0f);
+  }
+  this->spread_speed_ms_ = speed_ms;
+  this->spread_jitter_ms_ = jitter_ms;
+}
+
+uint32_t TypingModel::delay(Xoshiro128 &rng, uint32_t speed_ms, uint32_t jitter_ms, uint8_t from, uint8_t to) {
+  if (jitter_ms == 0) return speed_ms;
+  if (speed_ms != this->spread_speed_ms_ || jitter_ms != this->spread_jitter_ms_) this->set_spread_(speed_ms, jitter_ms);
+  // Top 6 bits pick the bin, the next 8 interpolate inside it (inverse CDF)
+  uint32_t r = rng.next();
+  uint8_t bin = r >> 26;
+  int32_t frac = (r >> 18) & 0xFF;
+  int32_t spread = this->spread_[bin] + (((int32_t) this->spread_[bin + 1] - this->spread_[bin]) * frac >> 8);
+  uint32_t delay_ms = ((uint64_t) speed_ms * DIGRAPH_LATENCY[classify(from, to)] * spread) >> 16;
+  return delay_ms > 10 ? delay_ms : 10;
+}
+
+}  // namespace hid_common
+}  // namespace esphome
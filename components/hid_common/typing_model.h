@@ -0,0 +1,35 @@
+#pragma once
+
+#include "xoshiro.h"
+
+#include <cstdint>
+
+namespace esphome {
+namespace hid_common {
+
+// Inter-key delay model used when typing with jitter.
+//
+// Each delay is speed * digraph factor * exp(sigma * z): the digraph factor
+// depends on which fingers type the two keys (HID usages are physical key
+// positions, so this holds for every layout), and z is a standard normal
+// sample, giving the log-normal spread of human inter-key intervals. sigma is
+// jitter / speed, so for small values jitter keeps roughly its old meaning of
+// a spread around speed. Without jitter the delay is exactly speed.
+class TypingModel {
+ public:
+  // Delay after typing usage `from` and before typing usage `to` (0 if unknown)
+  uint32_t delay(Xoshiro128 &rng, uint32_t speed_ms, uint32_t jitter_ms, uint8_t from, uint8_t to);
+
+ protected:
+  static const uint8_t SPREAD_STEPS = 64;
+  void set_spread_(uint32_t speed_ms, uint32_t jitter_ms);
+
+  // exp(sigma * z) at the normal quantiles of SPREAD_STEPS equal-probability
+  // bins, in 8.8 fixed point; rebuilt only when speed or jitter change
+  uint16_t spread_[SPREAD_STEPS + 1];
+  uint32_t spread_speed_ms_{0};
+  uint32_t spread_jitter_ms_{0};
+};
+
+}  // namespace hid_common
+}  // namespace esphome
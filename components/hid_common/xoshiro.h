@@ -0,0 +1,58 @@
+#pragma once
+
+#include "esphome/core/helpers.h"
+
+#include <cstdint>
+
+namespace esphome {
+namespace hid_common {
+
+// xoshiro128** generator: a few shifts and rotates per draw, state kept per
+// instance instead of the shared newlib rand() state
+class Xoshiro128 {
+ public:
+  Xoshiro128() { this->seed(random_uint32()); }
+
+  void seed(uint32_t seed) {
+    // splitmix32 spreads a single seed word over the whole state
+    for (uint32_t &word : this->state_) {
+      uint32_t z = (seed += 0x9E3779B9);
+      z = (z ^ (z >> 16)) * 0x85EBCA6B;
+      z = (z ^ (z >> 13)) * 0xC2B2AE35;
+      word = z ^ (z >> 16);
+    }
+  }
+
+  uint32_t next() {
+    uint32_t result = rotl_(this->state_[1] * 5, 7) * 9;
+    uint32_t t = this->state_[1] << 9;
+    this->state_[2] ^= this->state_[0];
+    this->state_[3] ^= this->state_[1];
+    this->state_[1] ^= this->state_[2];
+    this->state_[0] ^= this->state_[3];
+    this->state_[2] ^= t;
+    this->state_[3] = rotl_(this->state_[3], 11);
+    return result;
+  }
+
+  // Uniform in [0, bound) without modulo bias (multiply-shift with rejection)
+  uint32_t below(uint32_t bound) {
+    uint64_t m = (uint64_t) this->next() * bound;
+    if ((uint32_t) m < bound) {
+      uint32_t threshold = -bound % bound;
+      while ((uint32_t) m < threshold) m = (uint64_t) this->next() * bound;
+    }
+    return m >> 32;
+  }
+
+  // Uniform in [-span, span]
+  int32_t symmetric(uint32_t span) { return (int32_t) this->below(span * 2 + 1) - (int32_t) span; }
+
+ protected:
+  static uint32_t rotl_(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+  uint32_t state_[4];
+};
+
+}  // namespace hid_common
+}  // namespace esphome
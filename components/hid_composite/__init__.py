@@ -1,13 +1,45 @@
+import logging
+import struct
+
 import esphome.codegen as cg
 import esphome.config_validation as cv
+import esphome.final_validate as fv
 from esphome import automation
+from esphome.components.hid_common.keymaps import KEY_NAMES, LAYOUT_CHARS
 from esphome.const import CONF_ID
+from esphome.core import CORE
+
+from . import lzss
+
+_LOGGER = logging.getLogger(__name__)
 
 CODEOWNERS = ["@AntorFr"]
 DEPENDENCIES = ["esp32"]
+AUTO_LOAD = ["hid_common"]
 CONFLICTS_WITH = ["hid_mouse", "hid_keyboard", "hid_telephony"]
 
 CONF_LAYOUT = "layout"
+CONF_NKRO = "nkro"
+CONF_RUNTIME_LAYOUT = "runtime_layout"
+CONF_ABSOLUTE_POINTER = "absolute_pointer"
+CONF_WIDE_MOUSE_REPORT = "wide_mouse_report"
+CONF_HIGH_RESOLUTION_SCROLL = "high_resolution_scroll"
+CONF_RECORDING = "recording"
+CONF_POINTER_BALLISTICS = "pointer_ballistics"
+CONF_PROFILE = "profile"
+CONF_SENSITIVITY = "sensitivity"
+CONF_SPEED_SCALE = "speed_scale"
+CONF_CURVE = "curve"
+CONF_MAX_SIZE = "max_size"
+CONF_FILESYSTEM = "filesystem"
+CONF_PARTITION = "partition"
+CONF_BASE_PATH = "base_path"
+CONF_FORMAT_IF_MOUNT_FAILED = "format_if_mount_failed"
+CONF_TEXT_STREAM = "text_stream"
+CONF_BUFFER_SIZE = "buffer_size"
+CONF_SPEED = "speed"
+CONF_JITTER = "jitter"
+CONF_UNICODE = "unicode"
 
 hid_composite_ns = cg.esphome_ns.namespace("hid_composite")
 HIDComposite = hid_composite_ns.class_("HIDComposite", cg.Component)
@@ -20,10 +52,29 @@ KEYBOARD_LAYOUTS = {
     "QWERTZ_DE": KeyboardLayout.LAYOUT_QWERTZ_DE,
 }
 
+# Unicode entry methods for characters outside the layout
+UnicodeMode = hid_composite_ns.enum("UnicodeMode")
+UNICODE_MODES = {
+    "NONE": UnicodeMode.UNICODE_NONE,
+    "LINUX": UnicodeMode.UNICODE_LINUX,
+    "WINDOWS_ALT": UnicodeMode.UNICODE_WINDOWS_ALT,
+    "WINDOWS_HEX": UnicodeMode.UNICODE_WINDOWS_HEX,
+    "MACOS": UnicodeMode.UNICODE_MACOS,
+}
+
 # Mouse Actions
 MoveAction = hid_composite_ns.class_("MoveAction", automation.Action)
+MovePathAction = hid_composite_ns.class_("MovePathAction", automation.Action)
+MoveAbsoluteAction = hid_composite_ns.class_("MoveAbsoluteAction", automation.Action)
+MovePixelsAction = hid_composite_ns.class_("MovePixelsAction", automation.Action)
 ScrollAction = hid_composite_ns.class_("ScrollAction", automation.Action)
+KineticScrollAction = hid_composite_ns.class_("KineticScrollAction", automation.Action)
+StartRecordingAction = hid_composite_ns.class_("StartRecordingAction", automation.Action)
+StopRecordingAction = hid_composite_ns.class_("StopRecordingAction", automation.Action)
+ReplayAction = hid_composite_ns.class_("ReplayAction", automation.Action)
 ClickAction = hid_composite_ns.class_("ClickAction", automation.Action)
+DoubleClickAction = hid_composite_ns.class_("DoubleClickAction", automation.Action)
+DragAction = hid_composite_ns.class_("DragAction", automation.Action)
 MousePressAction = hid_composite_ns.class_("MousePressAction", automation.Action)
 MouseReleaseAction = hid_composite_ns.class_("MouseReleaseAction", automation.Action)
 MouseReleaseAllAction = hid_composite_ns.class_("MouseReleaseAllAction", automation.Action)
@@ -32,8 +83,13 @@ MouseReleaseAllAction = hid_composite_ns.class_("MouseReleaseAllAction", automat
 KeyPressAction = hid_composite_ns.class_("KeyPressAction", automation.Action)
 KeyReleaseAction = hid_composite_ns.class_("KeyReleaseAction", automation.Action)
 KeyTapAction = hid_composite_ns.class_("KeyTapAction", automation.Action)
+KeyPressUsageAction = hid_composite_ns.class_("KeyPressUsageAction", automation.Action)
+KeyReleaseUsageAction = hid_composite_ns.class_("KeyReleaseUsageAction", automation.Action)
+KeyTapUsageAction = hid_composite_ns.class_("KeyTapUsageAction", automation.Action)
+ChordAction = hid_composite_ns.class_("ChordAction", automation.Action)
 KeyReleaseAllAction = hid_composite_ns.class_("KeyReleaseAllAction", automation.Action)
 TypeAction = hid_composite_ns.class_("TypeAction", automation.Action)
+TypeFileAction = hid_composite_ns.class_("TypeFileAction", automation.Action)
 
 # Keep Awake Actions
 StartMouseKeepAwakeAction = hid_composite_ns.class_("StartMouseKeepAwakeAction", automation.Action)
@@ -101,24 +157,163 @@ def validate_modifiers(value):
         raise cv.Invalid(f"Unknown modifier: {value}")
     raise cv.Invalid(f"Invalid modifier type: {type(value)}")
 
+def validate_key(value):
+    value = cv.string(value)
+    if len(value) > 1 and value.upper() not in KEY_NAMES:
+        raise cv.Invalid(f"Unknown key: {value}")
+    return value
+
+def resolve_key(key):
+    """Resolve a literal key to (HID usage, implied modifier) for the configured layout.
+
+    Characters are left unresolved (None) with runtime_layout, since the layout
+    they are typed with is only known when the action runs.
+    """
+    if len(key) > 1:
+        return KEY_NAMES[key.upper()], 0
+    config = CORE.config["hid_composite"]
+    if config[CONF_RUNTIME_LAYOUT]:
+        return None
+    return LAYOUT_CHARS[str(config[CONF_LAYOUT])].get(key)
+
+# Host pointer ballistics, as (counts, pixels) per report for the report's speed
+# magnitude, normalised to one pixel per count at the slowest speed.
+# WINDOWS is the default "Enhance pointer precision" curve (SmoothMouseXCurve /
+# SmoothMouseYCurve) with one curve unit of mouse speed taken as 3.5 counts per
+# report.
+WINDOWS_CURVE_X = (0.0, 0.43, 1.25, 3.86, 40.0)
+WINDOWS_CURVE_Y = (0.0, 1.37, 5.30, 24.30, 568.0)
+BALLISTICS_PROFILES = {
+    "LINEAR": [(0.0, 0.0), (1.0, 1.0)],
+    "WINDOWS": [(x * 3.5, y * 3.5 * WINDOWS_CURVE_X[1] / WINDOWS_CURVE_Y[1])
+                for x, y in zip(WINDOWS_CURVE_X, WINDOWS_CURVE_Y)],
+}
+
+def validate_curve(value):
+    value = cv.ensure_list(cv.ensure_list(cv.float_))(value)
+    points = [(0.0, 0.0)]
+    for point in value:
+        if len(point) != 2:
+            raise cv.Invalid("curve points are [counts, pixels] pairs")
+        if point[0] <= points[-1][0] or point[1] <= points[-1][1]:
+            raise cv.Invalid("curve counts and pixels must both increase from point to point")
+        points.append(tuple(point))
+    if len(points) > 16:
+        raise cv.Invalid("curve takes at most 15 points")
+    return points
+
+def ballistics_points(config):
+    """Curve points as the firmware gets them: speed_scale and sensitivity applied, in float32."""
+    points = config.get(CONF_CURVE) or BALLISTICS_PROFILES[config[CONF_PROFILE]]
+    scale = config[CONF_SPEED_SCALE]
+    return [
+        struct.unpack("2f", struct.pack("2f", counts * scale, pixels * scale * config[CONF_SENSITIVITY]))
+        for counts, pixels in points
+    ]
+
+def validate_ballistics(config):
+    if (config[CONF_PROFILE] == "CUSTOM") != (CONF_CURVE in config):
+        raise cv.Invalid("curve: is required with profile: CUSTOM and only allowed with it")
+    # The firmware interpolates between points, so they must still increase
+    # once scaled and rounded to float32
+    points = ballistics_points(config)
+    for a, b in zip(points, points[1:]):
+        if b[0] <= a[0] or b[1] <= a[1]:
+            raise cv.Invalid(
+                f"curve point [{b[0]:g}, {b[1]:g}] does not increase from [{a[0]:g}, {a[1]:g}] "
+                "after speed_scale and sensitivity"
+            )
+    return config
+
 CONFIG_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.declare_id(HIDComposite),
     cv.Optional(CONF_LAYOUT, default="QWERTY_US"): cv.enum(KEYBOARD_LAYOUTS, upper=True),
+    # Keep every layout compiled in so set_layout() can switch at runtime
+    cv.Optional(CONF_RUNTIME_LAYOUT, default=False): cv.boolean,
+    cv.Optional(CONF_NKRO, default=False): cv.boolean,
+    # 16-bit X/Y/wheel/pan in the mouse report instead of 8-bit
+    cv.Optional(CONF_WIDE_MOUSE_REPORT, default=False): cv.boolean,
+    # Resolution Multiplier feature report for wheel and AC Pan
+    cv.Optional(CONF_HIGH_RESOLUTION_SCROLL, default=False): cv.boolean,
+    # Second pointer collection with absolute X/Y, for hid_composite.move_absolute
+    cv.Optional(CONF_ABSOLUTE_POINTER, default=False): cv.boolean,
+    # SPIFFS partition mounted for hid_composite.type_file
+    cv.Optional(CONF_FILESYSTEM): cv.Schema({
+        cv.Optional(CONF_PARTITION, default="spiffs"): cv.string,
+        cv.Optional(CONF_BASE_PATH, default="/spiffs"): cv.string,
+        cv.Optional(CONF_FORMAT_IF_MOUNT_FAILED, default=False): cv.boolean,
+    }),
+    # Mouse recordings saved to flash, one preference of max_size bytes per name
+    cv.Optional(CONF_RECORDING): cv.Schema({
+        cv.Optional(CONF_MAX_SIZE, default=512): cv.int_range(min=64, max=4096),
+    }),
+    # Host pointer acceleration model for hid_composite.move_pixels
+    cv.Optional(CONF_POINTER_BALLISTICS): cv.All(cv.Schema({
+        cv.Optional(CONF_PROFILE, default="WINDOWS"): cv.one_of("LINEAR", "WINDOWS", "CUSTOM", upper=True),
+        # Pixels per count at the slowest speed
+        cv.Optional(CONF_SENSITIVITY, default=1.0): cv.float_range(min=0.01, max=100),
+        # Stretches the speed axis: above 1, acceleration starts at larger reports
+        cv.Optional(CONF_SPEED_SCALE, default=1.0): cv.float_range(min=0.1, max=10),
+        # [counts, pixels] per report, from slowest to fastest
+        cv.Optional(CONF_CURVE): validate_curve,
+    }), validate_ballistics),
+    # type_text_chunk API service feeding a ring buffer drained by the typing engine
+    cv.Optional(CONF_TEXT_STREAM): cv.All(cv.Schema({
+        cv.Optional(CONF_BUFFER_SIZE, default=2048): cv.int_range(min=256, max=32768),
+        cv.Optional(CONF_SPEED, default=50): cv.positive_int,
+        cv.Optional(CONF_JITTER, default=0): cv.positive_int,
+        cv.Optional(CONF_UNICODE, default="NONE"): cv.enum(UNICODE_MODES, upper=True),
+    }), cv.requires_component("api")),
 }).extend(cv.COMPONENT_SCHEMA)
 
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
     cg.add(var.set_layout(config[CONF_LAYOUT]))
+    if not config[CONF_RUNTIME_LAYOUT]:
+        cg.add_define(f"USE_HID_COMPOSITE_LAYOUT_{config[CONF_LAYOUT]}")
+    if config[CONF_NKRO]:
+        cg.add_define("USE_HID_COMPOSITE_NKRO")
+    if config[CONF_WIDE_MOUSE_REPORT]:
+        cg.add_define("USE_HID_COMPOSITE_WIDE_MOUSE")
+    if config[CONF_HIGH_RESOLUTION_SCROLL]:
+        cg.add_define("USE_HID_COMPOSITE_HIRES_SCROLL")
+    if config[CONF_ABSOLUTE_POINTER]:
+        cg.add_define("USE_HID_COMPOSITE_ABSOLUTE_POINTER")
+    if CONF_FILESYSTEM in config:
+        fs = config[CONF_FILESYSTEM]
+        cg.add_define("USE_HID_COMPOSITE_SPIFFS")
+        cg.add(var.set_spiffs(fs[CONF_PARTITION], fs[CONF_BASE_PATH], fs[CONF_FORMAT_IF_MOUNT_FAILED]))
+    if CONF_POINTER_BALLISTICS in config:
+        ballistics = config[CONF_POINTER_BALLISTICS]
+        cg.add_define("USE_HID_COMPOSITE_BALLISTICS")
+        for counts, pixels in ballistics_points(ballistics):
+            cg.add(var.add_ballistics_point(counts, pixels))
+    if CONF_RECORDING in config:
+        cg.add_define("USE_HID_COMPOSITE_RECORDING")
+        cg.add_define("HID_COMPOSITE_RECORDING_SIZE", config[CONF_RECORDING][CONF_MAX_SIZE])
+    if CONF_TEXT_STREAM in config:
+        stream = config[CONF_TEXT_STREAM]
+        cg.add_define("USE_HID_COMPOSITE_TEXT_STREAM")
+        cg.add(var.set_text_stream(stream[CONF_BUFFER_SIZE], stream[CONF_SPEED], stream[CONF_JITTER],
+                                   stream[CONF_UNICODE]))
 
 # ============ Mouse Actions ============
 
 MOVE_ACTION_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.use_id(HIDComposite),
-    cv.Required(CONF_X): cv.templatable(cv.int_range(min=-127, max=127)),
-    cv.Required(CONF_Y): cv.templatable(cv.int_range(min=-127, max=127)),
+    cv.Required(CONF_X): cv.templatable(cv.int_range(min=-32767, max=32767)),
+    cv.Required(CONF_Y): cv.templatable(cv.int_range(min=-32767, max=32767)),
 })
 
+def final_validate_mouse_delta(config, action):
+    """A relative motion that fits one mouse report."""
+    if config[CONF_WIDE_MOUSE_REPORT]:
+        return
+    for key in (CONF_X, CONF_Y):
+        if isinstance(action[key], int) and not -127 <= action[key] <= 127:
+            raise cv.Invalid(f"hid_composite.move {key} must be between -127 and 127 without wide_mouse_report: true")
+
 @automation.register_action("hid_composite.move", MoveAction, MOVE_ACTION_SCHEMA)
 async def move_action_to_code(config, action_id, template_arg, args):
     var = cg.new_Pvariable(action_id, template_arg)
@@ -129,22 +324,175 @@ async def move_action_to_code(config, action_id, template_arg, args):
     cg.add(var.set_y(template_))
     return var
 
+MOVE_ABSOLUTE_ACTION_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.use_id(HIDComposite),
+    cv.Required(CONF_X): cv.templatable(cv.int_range(min=0, max=32767)),
+    cv.Required(CONF_Y): cv.templatable(cv.int_range(min=0, max=32767)),
+})
+
+def final_validate_absolute_pointer(config, action):
+    if not config[CONF_ABSOLUTE_POINTER]:
+        raise cv.Invalid("hid_composite.move_absolute needs absolute_pointer: true")
+
+@automation.register_action("hid_composite.move_absolute", MoveAbsoluteAction, MOVE_ABSOLUTE_ACTION_SCHEMA)
+async def move_absolute_action_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    template_ = await cg.templatable(config[CONF_X], args, cg.uint16)
+    cg.add(var.set_x(template_))
+    template_ = await cg.templatable(config[CONF_Y], args, cg.uint16)
+    cg.add(var.set_y(template_))
+    return var
+
+MOVE_PIXELS_ACTION_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.use_id(HIDComposite),
+    cv.Required(CONF_X): cv.templatable(cv.int_range(min=-100000, max=100000)),
+    cv.Required(CONF_Y): cv.templatable(cv.int_range(min=-100000, max=100000)),
+})
+
+def final_validate_ballistics(config, action):
+    if CONF_POINTER_BALLISTICS not in config:
+        raise cv.Invalid("hid_composite.move_pixels needs a pointer_ballistics: block on hid_composite")
+
+@automation.register_action("hid_composite.move_pixels", MovePixelsAction, MOVE_PIXELS_ACTION_SCHEMA)
+async def move_pixels_action_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    template_ = await cg.templatable(config[CONF_X], args, cg.int32)
+    cg.add(var.set_x(template_))
+    template_ = await cg.templatable(config[CONF_Y], args, cg.int32)
+    cg.add(var.set_y(template_))
+    return var
+
+CONF_DURATION = "duration"
+CONF_EASING = "easing"
+CONF_BEZIER = "bezier"
+
+# Control points of the cubic Bézier timing curve, as in CSS
+EASINGS = {
+    "LINEAR": (0.0, 0.0, 1.0, 1.0),
+    "EASE": (0.25, 0.1, 0.25, 1.0),
+    "EASE_IN": (0.42, 0.0, 1.0, 1.0),
+    "EASE_OUT": (0.0, 0.0, 0.58, 1.0),
+    "EASE_IN_OUT": (0.42, 0.0, 0.58, 1.0),
+}
+
+def validate_bezier(value):
+    value = cv.ensure_list(cv.float_)(value)
+    if len(value) != 4:
+        raise cv.Invalid("bezier takes four values: [x1, y1, x2, y2]")
+    if not (0.0 <= value[0] <= 1.0 and 0.0 <= value[2] <= 1.0):
+        raise cv.Invalid("bezier x1 and x2 must be between 0 and 1")
+    return value
+
+MOVE_PATH_ACTION_SCHEMA = cv.All(
+    cv.Schema({
+        cv.GenerateID(): cv.use_id(HIDComposite),
+        cv.Required(CONF_X): cv.templatable(cv.int_range(min=-32767, max=32767)),
+        cv.Required(CONF_Y): cv.templatable(cv.int_range(min=-32767, max=32767)),
+        cv.Optional(CONF_DURATION, default="500ms"): cv.templatable(cv.positive_time_period_milliseconds),
+        cv.Optional(CONF_EASING): cv.one_of(*EASINGS, upper=True),
+        cv.Optional(CONF_BEZIER): validate_bezier,
+    }),
+    cv.has_at_most_one_key(CONF_EASING, CONF_BEZIER),
+)
+
+@automation.register_action("hid_composite.move_path", MovePathAction, MOVE_PATH_ACTION_SCHEMA)
+async def move_path_action_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    template_ = await cg.templatable(config[CONF_X], args, cg.int32)
+    cg.add(var.set_x(template_))
+    template_ = await cg.templatable(config[CONF_Y], args, cg.int32)
+    cg.add(var.set_y(template_))
+    template_ = await cg.templatable(config[CONF_DURATION], args, cg.uint32)
+    cg.add(var.set_duration(template_))
+    points = config.get(CONF_BEZIER, EASINGS[config.get(CONF_EASING, "EASE_IN_OUT")])
+    cg.add(var.set_easing(*points))
+    return var
+
 SCROLL_ACTION_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.use_id(HIDComposite),
-    cv.Optional(CONF_VERTICAL, default=0): cv.templatable(cv.int_range(min=-127, max=127)),
-    cv.Optional(CONF_HORIZONTAL, default=0): cv.templatable(cv.int_range(min=-127, max=127)),
+    # Detents; fractions accumulate, amounts beyond one report are sent over several frames
+    cv.Optional(CONF_VERTICAL, default=0): cv.templatable(cv.float_range(min=-1000, max=1000)),
+    cv.Optional(CONF_HORIZONTAL, default=0): cv.templatable(cv.float_range(min=-1000, max=1000)),
 })
 
 @automation.register_action("hid_composite.scroll", ScrollAction, SCROLL_ACTION_SCHEMA)
 async def scroll_action_to_code(config, action_id, template_arg, args):
     var = cg.new_Pvariable(action_id, template_arg)
     await cg.register_parented(var, config[CONF_ID])
-    template_ = await cg.templatable(config[CONF_VERTICAL], args, cg.int_)
+    template_ = await cg.templatable(config[CONF_VERTICAL], args, cg.float_)
     cg.add(var.set_vertical(template_))
-    template_ = await cg.templatable(config[CONF_HORIZONTAL], args, cg.int_)
+    template_ = await cg.templatable(config[CONF_HORIZONTAL], args, cg.float_)
     cg.add(var.set_horizontal(template_))
     return var
 
+CONF_FRICTION = "friction"
+
+KINETIC_SCROLL_ACTION_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.use_id(HIDComposite),
+    # Initial velocities in detents per second
+    cv.Optional(CONF_VERTICAL, default=0): cv.templatable(cv.float_range(min=-1000, max=1000)),
+    cv.Optional(CONF_HORIZONTAL, default=0): cv.templatable(cv.float_range(min=-1000, max=1000)),
+    # Decay constant per second: the scroll travels velocity / friction detents
+    cv.Optional(CONF_FRICTION, default=4.0): cv.templatable(cv.float_range(min=0.1, max=100)),
+})
+
+@automation.register_action("hid_composite.kinetic_scroll", KineticScrollAction, KINETIC_SCROLL_ACTION_SCHEMA)
+async def kinetic_scroll_action_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    template_ = await cg.templatable(config[CONF_VERTICAL], args, cg.float_)
+    cg.add(var.set_vertical(template_))
+    template_ = await cg.templatable(config[CONF_HORIZONTAL], args, cg.float_)
+    cg.add(var.set_horizontal(template_))
+    template_ = await cg.templatable(config[CONF_FRICTION], args, cg.float_)
+    cg.add(var.set_friction(template_))
+    return var
+
+CONF_NAME = "name"
+
+def final_validate_recording(config, action):
+    if CONF_RECORDING not in config:
+        raise cv.Invalid("Mouse recording needs a recording: block on hid_composite")
+
+START_RECORDING_ACTION_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.use_id(HIDComposite),
+    cv.Required(CONF_NAME): cv.templatable(cv.string_strict),
+})
+
+@automation.register_action("hid_composite.start_recording", StartRecordingAction, START_RECORDING_ACTION_SCHEMA)
+async def start_recording_action_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    template_ = await cg.templatable(config[CONF_NAME], args, cg.std_string)
+    cg.add(var.set_name(template_))
+    return var
+
+STOP_RECORDING_ACTION_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.use_id(HIDComposite),
+})
+
+@automation.register_action("hid_composite.stop_recording", StopRecordingAction, STOP_RECORDING_ACTION_SCHEMA)
+async def stop_recording_action_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    return var
+
+REPLAY_ACTION_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.use_id(HIDComposite),
+    cv.Required(CONF_NAME): cv.templatable(cv.string_strict),
+})
+
+@automation.register_action("hid_composite.replay", ReplayAction, REPLAY_ACTION_SCHEMA)
+async def replay_action_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    template_ = await cg.templatable(config[CONF_NAME], args, cg.std_string)
+    cg.add(var.set_name(template_))
+    return var
+
 CLICK_ACTION_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.use_id(HIDComposite),
     cv.Optional(CONF_BUTTON, default="LEFT"): cv.templatable(validate_button),
@@ -158,6 +506,46 @@ async def click_action_to_code(config, action_id, template_arg, args):
     cg.add(var.set_button(template_))
     return var
 
+DOUBLE_CLICK_ACTION_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.use_id(HIDComposite),
+    cv.Optional(CONF_BUTTON, default="LEFT"): cv.templatable(validate_button),
+    # Gap between the first release and the second press; keep it below the
+    # host's double-click time
+    cv.Optional(CONF_INTERVAL, default="100ms"): cv.templatable(cv.positive_time_period_milliseconds),
+})
+
+@automation.register_action("hid_composite.double_click", DoubleClickAction, DOUBLE_CLICK_ACTION_SCHEMA)
+async def double_click_action_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    template_ = await cg.templatable(config[CONF_BUTTON], args, cg.uint8)
+    cg.add(var.set_button(template_))
+    template_ = await cg.templatable(config[CONF_INTERVAL], args, cg.uint32)
+    cg.add(var.set_interval(template_))
+    return var
+
+DRAG_ACTION_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.use_id(HIDComposite),
+    cv.Optional(CONF_BUTTON, default="LEFT"): cv.templatable(validate_button),
+    cv.Required(CONF_X): cv.templatable(cv.int_range(min=-32767, max=32767)),
+    cv.Required(CONF_Y): cv.templatable(cv.int_range(min=-32767, max=32767)),
+    cv.Optional(CONF_DURATION, default="500ms"): cv.templatable(cv.positive_time_period_milliseconds),
+})
+
+@automation.register_action("hid_composite.drag", DragAction, DRAG_ACTION_SCHEMA)
+async def drag_action_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    template_ = await cg.templatable(config[CONF_BUTTON], args, cg.uint8)
+    cg.add(var.set_button(template_))
+    template_ = await cg.templatable(config[CONF_X], args, cg.int32)
+    cg.add(var.set_x(template_))
+    template_ = await cg.templatable(config[CONF_Y], args, cg.int32)
+    cg.add(var.set_y(template_))
+    template_ = await cg.templatable(config[CONF_DURATION], args, cg.uint32)
+    cg.add(var.set_duration(template_))
+    return var
+
 MOUSE_PRESS_ACTION_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.use_id(HIDComposite),
     cv.Optional(CONF_BUTTON, default="LEFT"): cv.templatable(validate_button),
@@ -196,44 +584,111 @@ async def mouse_release_all_action_to_code(config, action_id, template_arg, args
 
 # ============ Keyboard Actions ============
 
+async def key_action_to_code(config, action_id, template_arg, args, usage_action):
+    # Literal keys are resolved here and built as the usage_action class, which
+    # only holds the prebuilt keycode; the string key is kept for lambdas (and
+    # characters left to a runtime layout).
+    key = config[CONF_KEY]
+    resolved = None if cg.is_template(key) else resolve_key(key)
+    if resolved is not None:
+        usage, modifier = resolved
+        action_id = action_id.copy()
+        action_id.type = usage_action
+        var = cg.new_Pvariable(action_id, template_arg)
+        await cg.register_parented(var, config[CONF_ID])
+        cg.add(var.set_usage(usage))
+        cg.add(var.set_modifier(config.get(CONF_MODIFIERS, 0) | modifier))
+        return var
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    template_ = await cg.templatable(key, args, cg.std_string)
+    cg.add(var.set_key(template_))
+    if CONF_MODIFIERS in config:
+        cg.add(var.set_modifier(config[CONF_MODIFIERS]))
+    return var
+
 KEY_PRESS_ACTION_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.use_id(HIDComposite),
-    cv.Required(CONF_KEY): cv.templatable(cv.string),
+    cv.Required(CONF_KEY): cv.templatable(validate_key),
     cv.Optional(CONF_MODIFIERS, default="NONE"): validate_modifiers,
 })
 
 @automation.register_action("hid_composite.key_press", KeyPressAction, KEY_PRESS_ACTION_SCHEMA)
 async def key_press_action_to_code(config, action_id, template_arg, args):
-    var = cg.new_Pvariable(action_id, template_arg)
-    await cg.register_parented(var, config[CONF_ID])
-    template_ = await cg.templatable(config[CONF_KEY], args, cg.std_string)
-    cg.add(var.set_key(template_))
-    cg.add(var.set_modifier(config[CONF_MODIFIERS]))
-    return var
+    return await key_action_to_code(config, action_id, template_arg, args, KeyPressUsageAction)
 
 KEY_RELEASE_ACTION_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.use_id(HIDComposite),
+    cv.Optional(CONF_KEY): cv.templatable(validate_key),
 })
 
 @automation.register_action("hid_composite.key_release", KeyReleaseAction, KEY_RELEASE_ACTION_SCHEMA)
 async def key_release_action_to_code(config, action_id, template_arg, args):
+    # Without a key every key is released; with one only that key leaves the pressed set
+    if CONF_KEY in config:
+        return await key_action_to_code(config, action_id, template_arg, args, KeyReleaseUsageAction)
     var = cg.new_Pvariable(action_id, template_arg)
     await cg.register_parented(var, config[CONF_ID])
     return var
 
 KEY_TAP_ACTION_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.use_id(HIDComposite),
-    cv.Required(CONF_KEY): cv.templatable(cv.string),
+    cv.Required(CONF_KEY): cv.templatable(validate_key),
     cv.Optional(CONF_MODIFIERS, default="NONE"): validate_modifiers,
 })
 
 @automation.register_action("hid_composite.key_tap", KeyTapAction, KEY_TAP_ACTION_SCHEMA)
 async def key_tap_action_to_code(config, action_id, template_arg, args):
+    return await key_action_to_code(config, action_id, template_arg, args, KeyTapUsageAction)
+
+CONF_KEYS = "keys"
+
+CHORD_ACTION_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.use_id(HIDComposite),
+    cv.Required(CONF_KEYS): cv.All(cv.ensure_list(validate_key), cv.Length(min=1)),
+    cv.Optional(CONF_MODIFIERS, default="NONE"): validate_modifiers,
+})
+
+def final_validate_chord(config, action):
+    keys = action[CONF_KEYS]
+    if not config[CONF_RUNTIME_LAYOUT]:
+        layout_chars = LAYOUT_CHARS[str(config[CONF_LAYOUT])]
+        for key in keys:
+            if len(key) == 1 and key not in layout_chars:
+                raise cv.Invalid(f"Key '{key}' cannot be typed with the {config[CONF_LAYOUT]} layout")
+    # Modifier keys are folded into the modifier byte; every other key takes a
+    # report slot, and the report holds KEYBOARD_ROLLOVER of them
+    slots = {key if len(key) == 1 else KEY_NAMES[key.upper()] for key in keys
+             if len(key) == 1 or not 0xE0 <= KEY_NAMES[key.upper()] <= 0xE7}
+    rollover = 16 if config[CONF_NKRO] else 6
+    if len(slots) > rollover:
+        raise cv.Invalid(
+            f"A chord holds at most {rollover} keys besides modifiers"
+            + ("" if config[CONF_NKRO] else " (16 with nkro: true)")
+        )
+
+@automation.register_action("hid_composite.chord", ChordAction, CHORD_ACTION_SCHEMA)
+async def chord_action_to_code(config, action_id, template_arg, args):
+    # The whole combination is resolved here and sent as one report;
+    # modifier keys in the list are folded into the modifier byte.
+    # Characters left to a runtime layout send the keys as strings instead.
     var = cg.new_Pvariable(action_id, template_arg)
     await cg.register_parented(var, config[CONF_ID])
-    template_ = await cg.templatable(config[CONF_KEY], args, cg.std_string)
-    cg.add(var.set_key(template_))
-    cg.add(var.set_modifier(config[CONF_MODIFIERS]))
+    modifier = config[CONF_MODIFIERS]
+    if CORE.config["hid_composite"][CONF_RUNTIME_LAYOUT] and any(len(key) == 1 for key in config[CONF_KEYS]):
+        cg.add(var.set_keys(config[CONF_KEYS]))
+        cg.add(var.set_modifier(modifier))
+        return var
+    usages = []
+    for key in config[CONF_KEYS]:
+        usage, implied = resolve_key(key)
+        modifier |= implied
+        if 0xE0 <= usage <= 0xE7:
+            modifier |= 1 << (usage - 0xE0)
+        elif usage not in usages:
+            usages.append(usage)
+    cg.add(var.set_usages(usages))
+    cg.add(var.set_modifier(modifier))
     return var
 
 KEY_RELEASE_ALL_ACTION_SCHEMA = cv.Schema({
@@ -246,26 +701,82 @@ async def key_release_all_action_to_code(config, action_id, template_arg, args):
     await cg.register_parented(var, config[CONF_ID])
     return var
 
-CONF_SPEED = "speed"
-CONF_JITTER = "jitter"
+CONF_BURST = "burst"
+CONF_DATA_ID = "data_id"
+
+# Literal texts at least this long are stored LZSS-compressed in flash
+COMPRESS_MIN_LENGTH = 256
 
 TYPE_ACTION_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.use_id(HIDComposite),
+    cv.GenerateID(CONF_DATA_ID): cv.declare_id(cg.uint8),
     cv.Required(CONF_TEXT): cv.templatable(cv.string),
     cv.Optional(CONF_SPEED, default=50): cv.templatable(cv.positive_int),
     cv.Optional(CONF_JITTER, default=0): cv.templatable(cv.positive_int),
+    cv.Optional(CONF_BURST, default=False): cv.templatable(cv.boolean),
+    cv.Optional(CONF_UNICODE, default="NONE"): cv.enum(UNICODE_MODES, upper=True),
 })
 
+def compress_text(config):
+    """Compressed bytes for a long literal text, or None to keep it as a string."""
+    text = config[CONF_TEXT]
+    if cg.is_template(text) or config[CONF_BURST] is not False:
+        return None
+    raw = text.encode("utf-8")
+    if len(raw) < COMPRESS_MIN_LENGTH:
+        return None
+    packed = lzss.compress(raw)
+    if len(packed) >= len(raw) or lzss.decompress(packed) != raw:
+        return None
+    # Peak RAM while typing: the decoder window plus the source object
+    _LOGGER.info(
+        "hid_composite.type: %d-byte text stored as %d bytes in flash (%d%%), "
+        "decoded through a %d-byte window",
+        len(raw), len(packed), 100 * len(packed) // len(raw), lzss.WINDOW_SIZE,
+    )
+    return packed
+
 @automation.register_action("hid_composite.type", TypeAction, TYPE_ACTION_SCHEMA)
 async def type_action_to_code(config, action_id, template_arg, args):
+    packed = compress_text(config)
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    if packed is not None:
+        data = cg.static_const_array(config[CONF_DATA_ID], cg.ArrayInitializer(*packed))
+        cg.add(var.set_data(data, len(packed)))
+    else:
+        template_ = await cg.templatable(config[CONF_TEXT], args, cg.std_string)
+        cg.add(var.set_text(template_))
+        burst = await cg.templatable(config[CONF_BURST], args, cg.bool_)
+        cg.add(var.set_burst(burst))
+    speed = await cg.templatable(config[CONF_SPEED], args, cg.uint32)
+    cg.add(var.set_speed(speed))
+    jitter = await cg.templatable(config[CONF_JITTER], args, cg.uint32)
+    cg.add(var.set_jitter(jitter))
+    cg.add(var.set_unicode(config[CONF_UNICODE]))
+    return var
+
+CONF_PATH = "path"
+
+TYPE_FILE_ACTION_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.use_id(HIDComposite),
+    cv.Required(CONF_PATH): cv.templatable(cv.string),
+    cv.Optional(CONF_SPEED, default=50): cv.templatable(cv.positive_int),
+    cv.Optional(CONF_JITTER, default=0): cv.templatable(cv.positive_int),
+    cv.Optional(CONF_UNICODE, default="NONE"): cv.enum(UNICODE_MODES, upper=True),
+})
+
+@automation.register_action("hid_composite.type_file", TypeFileAction, TYPE_FILE_ACTION_SCHEMA)
+async def type_file_action_to_code(config, action_id, template_arg, args):
     var = cg.new_Pvariable(action_id, template_arg)
     await cg.register_parented(var, config[CONF_ID])
-    template_ = await cg.templatable(config[CONF_TEXT], args, cg.std_string)
-    cg.add(var.set_text(template_))
+    template_ = await cg.templatable(config[CONF_PATH], args, cg.std_string)
+    cg.add(var.set_path(template_))
     speed = await cg.templatable(config[CONF_SPEED], args, cg.uint32)
     cg.add(var.set_speed(speed))
     jitter = await cg.templatable(config[CONF_JITTER], args, cg.uint32)
     cg.add(var.set_jitter(jitter))
+    cg.add(var.set_unicode(config[CONF_UNICODE]))
     return var
 
 
@@ -299,7 +810,7 @@ async def stop_mouse_keep_awake_action_to_code(config, action_id, template_arg,
 
 START_KEYBOARD_KEEP_AWAKE_ACTION_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.use_id(HIDComposite),
-    cv.Required(CONF_KEY): cv.templatable(cv.string),
+    cv.Required(CONF_KEY): cv.templatable(validate_key),
     cv.Optional(CONF_INTERVAL, default="60s"): cv.templatable(cv.positive_time_period_milliseconds),
     cv.Optional(CONF_JITTER, default="0s"): cv.templatable(cv.positive_time_period_milliseconds),
 })
@@ -426,3 +937,36 @@ async def hang_up_action_to_code(config, action_id, template_arg, args):
     var = cg.new_Pvariable(action_id, template_arg)
     await cg.register_parented(var, config[CONF_ID])
     return var
+
+# ============ Final validation ============
+# Actions are validated before the hid_composite block is, so the checks that
+# depend on its options run here, once per use of the action in the config.
+
+FINAL_ACTION_CHECKS = (
+    ("hid_composite.move", final_validate_mouse_delta),
+    ("hid_composite.move_absolute", final_validate_absolute_pointer),
+    ("hid_composite.move_pixels", final_validate_ballistics),
+    ("hid_composite.chord", final_validate_chord),
+    ("hid_composite.start_recording", final_validate_recording),
+    ("hid_composite.stop_recording", final_validate_recording),
+    ("hid_composite.replay", final_validate_recording),
+)
+
+def iter_actions(value, name):
+    if isinstance(value, dict):
+        for key, item in value.items():
+            if key == name:
+                yield item
+            else:
+                yield from iter_actions(item, name)
+    elif isinstance(value, list):
+        for item in value:
+            yield from iter_actions(item, name)
+
+def final_validate(config):
+    full_config = fv.full_config.get()
+    for name, check in FINAL_ACTION_CHECKS:
+        for action in iter_actions(full_config, name):
+            check(config, action)
+
+FINAL_VALIDATE_SCHEMA = final_validate
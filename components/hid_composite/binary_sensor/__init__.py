@@ -22,6 +22,16 @@ HIDInCallBinarySensor = hid_composite_ns.class_(
 HIDRingingBinarySensor = hid_composite_ns.class_(
     "HIDRingingBinarySensor", binary_sensor.BinarySensor, cg.Component
 )
+HIDKeyboardLedBinarySensor = hid_composite_ns.class_(
+    "HIDKeyboardLedBinarySensor", binary_sensor.BinarySensor, cg.Component
+)
+
+# Host keyboard LED bits (see KeyboardLed)
+KEYBOARD_LEDS = {
+    "num_lock": 0x01,
+    "caps_lock": 0x02,
+    "scroll_lock": 0x04,
+}
 
 TYPES = {
     "connected": {
@@ -44,6 +54,18 @@ TYPES = {
         "device_class": "sound",
         "polling": False,
     },
+    "num_lock": {
+        "class": HIDKeyboardLedBinarySensor,
+        "polling": False,
+    },
+    "caps_lock": {
+        "class": HIDKeyboardLedBinarySensor,
+        "polling": False,
+    },
+    "scroll_lock": {
+        "class": HIDKeyboardLedBinarySensor,
+        "polling": False,
+    },
 }
 
 
@@ -83,6 +105,15 @@ CONFIG_SCHEMA = cv.typed_schema(
         ).extend({
             cv.GenerateID(CONF_HID_COMPOSITE_ID): cv.use_id(HIDComposite),
         }).extend(cv.COMPONENT_SCHEMA),
+        
+        **{
+            led: binary_sensor.binary_sensor_schema(
+                HIDKeyboardLedBinarySensor,
+            ).extend({
+                cv.GenerateID(CONF_HID_COMPOSITE_ID): cv.use_id(HIDComposite),
+            }).extend(cv.COMPONENT_SCHEMA)
+            for led in KEYBOARD_LEDS
+        },
     },
     default_type="connected",
 )
@@ -94,3 +125,5 @@ async def to_code(config):
     
     parent = await cg.get_variable(config[CONF_HID_COMPOSITE_ID])
     cg.add(var.set_parent(parent))
+    if config[CONF_TYPE] in KEYBOARD_LEDS:
+        cg.add(var.set_led(KEYBOARD_LEDS[config[CONF_TYPE]]))
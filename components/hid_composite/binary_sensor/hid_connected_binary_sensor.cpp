@@ -54,5 +54,19 @@ void HIDRingingBinarySensor::dump_config() {
   LOG_BINARY_SENSOR("", "HID Composite Ringing", this);
 }
 
+// ============ Keyboard LED Binary Sensor ============
+
+void HIDKeyboardLedBinarySensor::setup() {
+  this->publish_state((this->parent_->get_keyboard_leds() & this->led_) != 0);
+  this->parent_->add_on_keyboard_leds_callback([this](uint8_t leds) {
+    this->publish_state((leds & this->led_) != 0);
+  });
+}
+
+void HIDKeyboardLedBinarySensor::dump_config() {
+  LOG_BINARY_SENSOR("", "HID Composite Keyboard LED", this);
+  ESP_LOGCONFIG(TAG, "  LED mask: 0x%02X", this->led_);
+}
+
 }  // namespace hid_composite
 }  // namespace esphome
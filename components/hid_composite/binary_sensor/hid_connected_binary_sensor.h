@@ -52,5 +52,18 @@ class HIDRingingBinarySensor : public binary_sensor::BinarySensor, public Compon
   HIDComposite *parent_{nullptr};
 };
 
+class HIDKeyboardLedBinarySensor : public binary_sensor::BinarySensor, public Component {
+ public:
+  void setup() override;
+  void dump_config() override;
+  
+  void set_parent(HIDComposite *parent) { this->parent_ = parent; }
+  void set_led(uint8_t led) { this->led_ = led; }
+
+ protected:
+  HIDComposite *parent_{nullptr};
+  uint8_t led_{LED_CAPS_LOCK};
+};
+
 }  // namespace hid_composite
 }  // namespace esphome
@@ -1,6 +1,7 @@
 #include "hid_composite.h"
 #include "esphome/core/log.h"
 #include "esphome/core/hal.h"
+#include "esphome/components/hid_common/key_names.h"
 
 #ifdef USE_ESP32
 
@@ -10,6 +11,16 @@
 #include "tusb.h"
 #include "class/hid/hid_device.h"
 
+#ifdef USE_HID_COMPOSITE_SPIFFS
+#include "esp_spiffs.h"
+#endif
+
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
 namespace esphome {
 namespace hid_composite {
 
@@ -22,10 +33,19 @@ static HIDComposite *g_hid_composite_instance = nullptr;
 #define REPORT_ID_KEYBOARD   1
 #define REPORT_ID_MOUSE      2
 #define REPORT_ID_CONSUMER   5   // Consumer Control (media keys, mute)
+#define REPORT_ID_ABSOLUTE   6   // Absolute pointer (optional)
 // Telephony Report IDs - Simplified for Teams compatibility
 #define REPORT_ID_TELEPHONY_INPUT  0x03  // Input report (buttons to host)
 #define REPORT_ID_TELEPHONY_LED    0x04  // Output report (LEDs from host)
 
+// Keyboard report layout
+#ifdef USE_HID_COMPOSITE_NKRO
+static const uint8_t KEYBOARD_REPORT_SIZE = 29;  // modifiers + bitmap of usages 0x00-0xDF
+static_assert(CFG_TUD_HID_EP_BUFSIZE >= KEYBOARD_REPORT_SIZE + 1, "NKRO report does not fit CFG_TUD_HID_EP_BUFSIZE");
+#else
+static const uint8_t KEYBOARD_REPORT_SIZE = 8;   // modifiers + reserved + 6 keys
+#endif
+
 // Key codes
 enum KeyCode : uint8_t {
   KEY_NONE = 0x00,
@@ -46,8 +66,23 @@ enum KeyCode : uint8_t {
   KEY_INSERT = 0x49, KEY_HOME = 0x4A, KEY_PAGE_UP = 0x4B,
   KEY_DELETE = 0x4C, KEY_END = 0x4D, KEY_PAGE_DOWN = 0x4E,
   KEY_RIGHT_ARROW = 0x4F, KEY_LEFT_ARROW = 0x50, KEY_DOWN_ARROW = 0x51, KEY_UP_ARROW = 0x52,
+  KEY_NUM_LOCK = 0x53, KEY_KP_PLUS = 0x57, KEY_KP_1 = 0x59, KEY_KP_0 = 0x62,
+  KEY_LEFT_CTRL = 0xE0, KEY_RIGHT_GUI = 0xE7,
 };
 
+// Logical range and size of the relative mouse fields (X, Y, wheel, pan)
+#ifdef USE_HID_COMPOSITE_WIDE_MOUSE
+#define MOUSE_DELTA_ITEMS \
+    0x16, 0x01, 0x80,  /* Logical Minimum (-32767) */ \
+    0x26, 0xFF, 0x7F,  /* Logical Maximum (32767) */ \
+    0x75, 0x10         /* Report Size (16) */
+#else
+#define MOUSE_DELTA_ITEMS \
+    0x15, 0x81,        /* Logical Minimum (-127) */ \
+    0x25, 0x7F,        /* Logical Maximum (127) */ \
+    0x75, 0x08         /* Report Size (8) */
+#endif
+
 // Composite HID Report Descriptor (Keyboard + Mouse)
 static const uint8_t hid_report_descriptor[] = {
     // Keyboard
@@ -63,9 +98,11 @@ static const uint8_t hid_report_descriptor[] = {
     0x75, 0x01,        //   Report Size (1)
     0x95, 0x08,        //   Report Count (8)
     0x81, 0x02,        //   Input (Data, Variable, Absolute)
+#ifndef USE_HID_COMPOSITE_NKRO
     0x95, 0x01,        //   Report Count (1)
     0x75, 0x08,        //   Report Size (8)
     0x81, 0x01,        //   Input (Constant)
+#endif
     0x95, 0x05,        //   Report Count (5)
     0x75, 0x01,        //   Report Size (1)
     0x05, 0x08,        //   Usage Page (LEDs)
@@ -75,14 +112,26 @@ static const uint8_t hid_report_descriptor[] = {
     0x95, 0x01,        //   Report Count (1)
     0x75, 0x03,        //   Report Size (3)
     0x91, 0x01,        //   Output (Constant)
+#ifdef USE_HID_COMPOSITE_NKRO
+    // N-key rollover: one bit per usage 0x00-0xDF (modifiers are the byte above)
+    0x05, 0x07,        //   Usage Page (Keyboard)
+    0x19, 0x00,        //   Usage Minimum (0)
+    0x29, 0xDF,        //   Usage Maximum (223)
+    0x15, 0x00,        //   Logical Minimum (0)
+    0x25, 0x01,        //   Logical Maximum (1)
+    0x75, 0x01,        //   Report Size (1)
+    0x96, 0xE0, 0x00,  //   Report Count (224)
+    0x81, 0x02,        //   Input (Data, Variable, Absolute)
+#else
     0x95, 0x06,        //   Report Count (6)
     0x75, 0x08,        //   Report Size (8)
     0x15, 0x00,        //   Logical Minimum (0)
-    0x25, 0x65,        //   Logical Maximum (101)
+    0x26, 0xE7, 0x00,  //   Logical Maximum (231)
     0x05, 0x07,        //   Usage Page (Keyboard)
     0x19, 0x00,        //   Usage Minimum (0)
-    0x29, 0x65,        //   Usage Maximum (101)
+    0x29, 0xE7,        //   Usage Maximum (231)
     0x81, 0x00,        //   Input (Data, Array)
+#endif
     0xC0,              // End Collection
 
     // Mouse
@@ -106,22 +155,89 @@ static const uint8_t hid_report_descriptor[] = {
     0x05, 0x01,        //     Usage Page (Generic Desktop)
     0x09, 0x30,        //     Usage (X)
     0x09, 0x31,        //     Usage (Y)
+    MOUSE_DELTA_ITEMS,
+    0x95, 0x02,        //     Report Count (2)
+    0x81, 0x06,        //     Input (Data, Variable, Relative)
+#ifdef USE_HID_COMPOSITE_HIRES_SCROLL
+    // Wheel and AC Pan each get a Resolution Multiplier in the mouse feature
+    // report; once the host sets it, one detent is SCROLL_RESOLUTION units
+    0xA1, 0x02,        //     Collection (Logical)
+    0x09, 0x48,        //       Usage (Resolution Multiplier)
+    0x15, 0x00,        //       Logical Minimum (0)
+    0x25, 0x01,        //       Logical Maximum (1)
+    0x35, 0x01,        //       Physical Minimum (1)
+    0x45, SCROLL_RESOLUTION, //  Physical Maximum (SCROLL_RESOLUTION)
+    0x75, 0x02,        //       Report Size (2)
+    0x95, 0x01,        //       Report Count (1)
+    0xA4,              //       Push
+    0xB1, 0x02,        //       Feature (Data, Variable, Absolute)
+    0x09, 0x38,        //       Usage (Wheel)
+    0x35, 0x00,        //       Physical Minimum (0)
+    0x45, 0x00,        //       Physical Maximum (0)
+    MOUSE_DELTA_ITEMS,
+    0x95, 0x01,        //       Report Count (1)
+    0x81, 0x06,        //       Input (Data, Variable, Relative)
+    0xC0,              //     End Collection
+    0xA1, 0x02,        //     Collection (Logical)
+    0xB4,              //       Pop
+    0x09, 0x48,        //       Usage (Resolution Multiplier)
+    0xB1, 0x02,        //       Feature (Data, Variable, Absolute)
+    0x35, 0x00,        //       Physical Minimum (0)
+    0x45, 0x00,        //       Physical Maximum (0)
+    0x05, 0x0C,        //       Usage Page (Consumer)
+    0x0A, 0x38, 0x02,  //       Usage (AC Pan)
+    MOUSE_DELTA_ITEMS,
+    0x95, 0x01,        //       Report Count (1)
+    0x81, 0x06,        //       Input (Data, Variable, Relative)
+    0xC0,              //     End Collection
+    0x75, 0x04,        //     Report Size (4)
+    0x95, 0x01,        //     Report Count (1)
+    0xB1, 0x03,        //     Feature (Constant) - padding
+#else
     0x09, 0x38,        //     Usage (Wheel)
-    0x15, 0x81,        //     Logical Minimum (-127)
-    0x25, 0x7F,        //     Logical Maximum (127)
-    0x75, 0x08,        //     Report Size (8)
-    0x95, 0x03,        //     Report Count (3)
+    MOUSE_DELTA_ITEMS,
+    0x95, 0x01,        //     Report Count (1)
     0x81, 0x06,        //     Input (Data, Variable, Relative)
     0x05, 0x0C,        //     Usage Page (Consumer)
     0x0A, 0x38, 0x02,  //     Usage (AC Pan)
-    0x15, 0x81,        //     Logical Minimum (-127)
-    0x25, 0x7F,        //     Logical Maximum (127)
-    0x75, 0x08,        //     Report Size (8)
+    MOUSE_DELTA_ITEMS,
     0x95, 0x01,        //     Report Count (1)
     0x81, 0x06,        //     Input (Data, Variable, Relative)
+#endif
     0xC0,              //   End Collection
     0xC0,              // End Collection
 
+#ifdef USE_HID_COMPOSITE_ABSOLUTE_POINTER
+    // Absolute pointer: a second mouse whose X/Y are positions on the screen
+    0x05, 0x01,        // Usage Page (Generic Desktop)
+    0x09, 0x02,        // Usage (Mouse)
+    0xA1, 0x01,        // Collection (Application)
+    0x09, 0x01,        //   Usage (Pointer)
+    0xA1, 0x00,        //   Collection (Physical)
+    0x85, REPORT_ID_ABSOLUTE, // Report ID
+    0x05, 0x09,        //     Usage Page (Buttons)
+    0x19, 0x01,        //     Usage Minimum (Button 1)
+    0x29, 0x03,        //     Usage Maximum (Button 3)
+    0x15, 0x00,        //     Logical Minimum (0)
+    0x25, 0x01,        //     Logical Maximum (1)
+    0x95, 0x03,        //     Report Count (3)
+    0x75, 0x01,        //     Report Size (1)
+    0x81, 0x02,        //     Input (Data, Variable, Absolute)
+    0x95, 0x01,        //     Report Count (1)
+    0x75, 0x05,        //     Report Size (5)
+    0x81, 0x01,        //     Input (Constant)
+    0x05, 0x01,        //     Usage Page (Generic Desktop)
+    0x09, 0x30,        //     Usage (X)
+    0x09, 0x31,        //     Usage (Y)
+    0x15, 0x00,        //     Logical Minimum (0)
+    0x26, 0xFF, 0x7F,  //     Logical Maximum (32767)
+    0x75, 0x10,        //     Report Size (16)
+    0x95, 0x02,        //     Report Count (2)
+    0x81, 0x02,        //     Input (Data, Variable, Absolute)
+    0xC0,              //   End Collection
+    0xC0,              // End Collection
+#endif
+
     // ============================================
     // Consumer Control - Media Keys & Mute
     // This works with Teams on Windows!
@@ -254,10 +370,15 @@ static const uint8_t configuration_descriptor[] = {
 
 extern "C" {
 uint8_t const *tud_hid_descriptor_report_cb(uint8_t instance) { return hid_report_descriptor; }
-uint16_t tud_hid_get_report_cb(uint8_t instance, uint8_t report_id, hid_report_type_t report_type, uint8_t *buffer, uint16_t reqlen) { return 0; }
+uint16_t tud_hid_get_report_cb(uint8_t instance, uint8_t report_id, hid_report_type_t report_type, uint8_t *buffer, uint16_t reqlen) {
+  if (report_type == HID_REPORT_TYPE_FEATURE && g_hid_composite_instance != nullptr) {
+    return g_hid_composite_instance->get_feature_report(report_id, buffer, reqlen);
+  }
+  return 0;
+}
 
 void tud_hid_set_report_cb(uint8_t instance, uint8_t report_id, hid_report_type_t report_type, uint8_t const *buffer, uint16_t bufsize) {
-  // Log ALL reports from host for debugging
+  // Every report from the host, for debugging (verbose log level)
   const char* type_str = (report_type == HID_REPORT_TYPE_OUTPUT) ? "OUTPUT" : 
                          (report_type == HID_REPORT_TYPE_FEATURE) ? "FEATURE" : "UNKNOWN";
   
@@ -267,11 +388,13 @@ void tud_hid_set_report_cb(uint8_t instance, uint8_t report_id, hid_report_type_
     snprintf(hex_buf + i*3, 4, "%02X ", buffer[i]);
   }
   
-  ESP_LOGI("HID_RAW", ">>> HOST REPORT: instance=%d, id=0x%02X, type=%s, size=%d, data=[%s]", 
+  ESP_LOGV("HID_RAW", ">>> HOST REPORT: instance=%d, id=0x%02X, type=%s, size=%d, data=[%s]", 
            instance, report_id, type_str, bufsize, hex_buf);
   
   if (report_type == HID_REPORT_TYPE_OUTPUT && g_hid_composite_instance != nullptr) {
     g_hid_composite_instance->process_host_report(report_id, buffer, bufsize);
+  } else if (report_type == HID_REPORT_TYPE_FEATURE && g_hid_composite_instance != nullptr) {
+    g_hid_composite_instance->process_feature_report(report_id, buffer, bufsize);
   }
 }
 }
@@ -304,6 +427,28 @@ void HIDComposite::setup() {
   }
   ESP_LOGI(TAG, "TinyUSB driver installed successfully");
   this->initialized_ = true;
+
+#ifdef USE_HID_COMPOSITE_SPIFFS
+  // Filesystem for type_file; failure only disables file typing
+  esp_vfs_spiffs_conf_t spiffs_cfg = {
+    .base_path = this->spiffs_base_path_.c_str(),
+    .partition_label = this->spiffs_partition_.c_str(),
+    .max_files = 2,
+    .format_if_mount_failed = this->spiffs_format_,
+  };
+  ret = esp_vfs_spiffs_register(&spiffs_cfg);
+  if (ret != ESP_OK) {
+    ESP_LOGE(TAG, "SPIFFS mount of partition '%s' failed: %s", this->spiffs_partition_.c_str(), esp_err_to_name(ret));
+  } else {
+    ESP_LOGI(TAG, "SPIFFS partition '%s' mounted at %s", this->spiffs_partition_.c_str(), this->spiffs_base_path_.c_str());
+  }
+#endif
+
+#ifdef USE_HID_COMPOSITE_TEXT_STREAM
+  // Allocated once; chunk size is bounded by the free space, never by the text length
+  this->stream_buffer_.init(this->stream_buffer_size_);
+  this->register_service(&HIDComposite::on_text_chunk_, "type_text_chunk", {"seq", "text", "final"});
+#endif
 }
 
 void HIDComposite::loop() {
@@ -311,34 +456,93 @@ void HIDComposite::loop() {
   
   uint32_t now = millis();
   
-  // Handle mouse keep awake
-  if (this->mouse_keep_awake_enabled_) {
+  // Handle mouse keep awake: a one-count jiggle, undone in the next frame so the
+  // pointer ends where it was. Neither half changes which pointer buttons follow.
+  bool absolute = this->pointer_absolute_;
+  if (this->mouse_keep_awake_return_x_ != 0 || this->mouse_keep_awake_return_y_ != 0) {
+    if (this->send_jiggle_(this->mouse_keep_awake_return_x_, this->mouse_keep_awake_return_y_)) {
+      this->mouse_keep_awake_return_x_ = 0;
+      this->mouse_keep_awake_return_y_ = 0;
+      this->pointer_absolute_ = absolute;
+    }
+  } else if (this->mouse_keep_awake_enabled_) {
     if (now - this->mouse_keep_awake_last_time_ >= this->mouse_keep_awake_next_interval_) {
-      int8_t dx = (rand() % 3) - 1;
-      int8_t dy = (rand() % 3) - 1;
-      if (dx == 0 && dy == 0) dx = 1;
-      this->move(dx, dy);
-      ESP_LOGD(TAG, "Mouse keep awake: move(%d, %d)", dx, dy);
-      
-      this->mouse_keep_awake_next_interval_ = this->mouse_keep_awake_interval_;
-      if (this->mouse_keep_awake_jitter_ > 0) {
-        int32_t jitter = (rand() % (this->mouse_keep_awake_jitter_ * 2 + 1)) - this->mouse_keep_awake_jitter_;
-        this->mouse_keep_awake_next_interval_ = (int32_t)this->mouse_keep_awake_interval_ + jitter > 1000 
-                                                 ? this->mouse_keep_awake_interval_ + jitter : 1000;
+      // A pointer path, kinetic scroll or gesture already keeps the host awake
+      bool done = this->path_active_ || this->kinetic_active_ || this->gesture_count_ > 0;
+#ifdef USE_HID_COMPOSITE_BALLISTICS
+      done = done || this->pixels_active_;
+#endif
+      if (!done) {
+        int8_t dx = (int8_t) this->rng_.below(3) - 1;
+        int8_t dy = (int8_t) this->rng_.below(3) - 1;
+        if (dx == 0 && dy == 0) dx = 1;
+        if (this->send_jiggle_(dx, dy)) {
+          this->pointer_absolute_ = absolute;
+          this->mouse_keep_awake_return_x_ = -dx;
+          this->mouse_keep_awake_return_y_ = -dy;
+          ESP_LOGD(TAG, "Mouse keep awake: jiggle(%d, %d)", dx, dy);
+          done = true;
+        }
+      }
+
+      // Endpoint busy: try again on the next loop
+      if (done) {
+        this->mouse_keep_awake_next_interval_ = this->mouse_keep_awake_interval_;
+        if (this->mouse_keep_awake_jitter_ > 0) {
+          int32_t jitter = this->rng_.symmetric(this->mouse_keep_awake_jitter_);
+          this->mouse_keep_awake_next_interval_ = (int32_t)this->mouse_keep_awake_interval_ + jitter > 1000 
+                                                   ? this->mouse_keep_awake_interval_ + jitter : 1000;
+        }
+        this->mouse_keep_awake_last_time_ = now;
       }
-      this->mouse_keep_awake_last_time_ = now;
     }
   }
   
+  // Resolution multiplier changes arrive on the USB task; apply them before scrolling
+  this->apply_scroll_feature_();
+  this->process_kinetic_();
+  this->flush_scroll_();
+  this->process_gesture_();
+  this->process_path_();
+#ifdef USE_HID_COMPOSITE_BALLISTICS
+  this->process_pixels_();
+#endif
+#ifdef USE_HID_COMPOSITE_RECORDING
+  this->process_replay_();
+#endif
+  this->process_type_queue_();
+
+#ifdef USE_HID_COMPOSITE_TEXT_STREAM
+  // Tell the sender to resume once a refused chunk would likely fit
+  if (this->stream_blocked_ && this->stream_buffer_.free() >= this->stream_buffer_.capacity() / 2) {
+    this->stream_blocked_ = false;
+    this->send_stream_status_(this->stream_next_seq_, "ready");
+  }
+#endif
+
+  // Host LED changes arrive on the USB task; publish them from the main loop
+  uint8_t leds = this->keyboard_leds_;
+  if (leds != this->keyboard_leds_published_) {
+    this->keyboard_leds_published_ = leds;
+    this->keyboard_leds_callbacks_.call(leds);
+  }
+
   // Handle keyboard keep awake
   if (this->keyboard_keep_awake_enabled_) {
-    if (now - this->keyboard_keep_awake_last_time_ >= this->keyboard_keep_awake_next_interval_) {
-      this->key_tap(this->keyboard_keep_awake_key_);
-      ESP_LOGD(TAG, "Keyboard keep awake: tap(%s)", this->keyboard_keep_awake_key_.c_str());
+    // Typing or held keys already keep the host awake, and a tap would mix into
+    // their reports: wait until the keyboard is idle
+    bool busy = this->is_typing() || this->held_count_ > 0 || !this->tap_release_.empty();
+    if (!busy && now - this->keyboard_keep_awake_last_time_ >= this->keyboard_keep_awake_next_interval_) {
+      // Key was resolved when keep awake started; the release is scheduled instead of blocking
+      this->press_usage(this->keyboard_keep_awake_usage_, this->keyboard_keep_awake_modifier_);
+      this->set_timeout("keyboard_keep_awake", 10, [this]() {
+        this->release_usage(this->keyboard_keep_awake_usage_, this->keyboard_keep_awake_modifier_);
+      });
+      ESP_LOGV(TAG, "Keyboard keep awake: tap(0x%02X)", this->keyboard_keep_awake_usage_);
       
       this->keyboard_keep_awake_next_interval_ = this->keyboard_keep_awake_interval_;
       if (this->keyboard_keep_awake_jitter_ > 0) {
-        int32_t jitter = (rand() % (this->keyboard_keep_awake_jitter_ * 2 + 1)) - this->keyboard_keep_awake_jitter_;
+        int32_t jitter = this->rng_.symmetric(this->keyboard_keep_awake_jitter_);
         this->keyboard_keep_awake_next_interval_ = (int32_t)this->keyboard_keep_awake_interval_ + jitter > 1000 
                                                    ? this->keyboard_keep_awake_interval_ + jitter : 1000;
       }
@@ -350,34 +554,773 @@ void HIDComposite::loop() {
 void HIDComposite::dump_config() {
   ESP_LOGCONFIG(TAG, "HID Composite (Mouse + Keyboard):");
   ESP_LOGCONFIG(TAG, "  Status: %s", this->initialized_ ? "Initialized" : "Not initialized");
+#ifdef HID_COMPOSITE_RUNTIME_LAYOUT
+  ESP_LOGCONFIG(TAG, "  Layout: %d (runtime switchable)", this->layout_);
+#else
+  ESP_LOGCONFIG(TAG, "  Layout: %d (fixed at compile time)", this->layout_);
+#endif
+#ifdef USE_HID_COMPOSITE_NKRO
+  ESP_LOGCONFIG(TAG, "  Keyboard report: NKRO (%d bytes)", KEYBOARD_REPORT_SIZE);
+#else
+  ESP_LOGCONFIG(TAG, "  Keyboard report: 6KRO (%d bytes)", KEYBOARD_REPORT_SIZE);
+#endif
+#ifdef USE_HID_COMPOSITE_HIRES_SCROLL
+  ESP_LOGCONFIG(TAG, "  High-resolution scroll: %u units per detent", SCROLL_RESOLUTION);
+#endif
+#ifdef USE_HID_COMPOSITE_ABSOLUTE_POINTER
+  ESP_LOGCONFIG(TAG, "  Absolute pointer: 0-%u", (unsigned) ABSOLUTE_MAX);
+#endif
+#ifdef USE_HID_COMPOSITE_BALLISTICS
+  ESP_LOGCONFIG(TAG, "  Pointer ballistics: %u curve points", this->ballistics_count_);
+#endif
+#ifdef USE_HID_COMPOSITE_RECORDING
+  ESP_LOGCONFIG(TAG, "  Mouse recordings: up to %u bytes", (unsigned) HID_COMPOSITE_RECORDING_SIZE);
+#endif
+#ifdef USE_HID_COMPOSITE_TEXT_STREAM
+  ESP_LOGCONFIG(TAG, "  Text stream buffer: %u bytes", (unsigned) this->stream_buffer_size_);
+#endif
 }
 
 // ============ Mouse Functions ============
 
-void HIDComposite::send_mouse_report() {
-  if (!this->initialized_ || !tud_mounted() || !tud_hid_ready()) return;
-  uint8_t report[5] = {this->mouse_buttons_, 0, 0, 0, 0};
-  tud_hid_report(REPORT_ID_MOUSE, report, sizeof(report));
+static int16_t clamp_delta(int32_t delta) {
+  return delta > MOUSE_DELTA_MAX ? MOUSE_DELTA_MAX : (delta < -MOUSE_DELTA_MAX ? -MOUSE_DELTA_MAX : delta);
 }
 
-void HIDComposite::move(int8_t x, int8_t y) {
-  if (!this->initialized_ || !tud_mounted() || !tud_hid_ready()) return;
-  uint8_t report[5] = {this->mouse_buttons_, (uint8_t)x, (uint8_t)y, 0, 0};
-  tud_hid_report(REPORT_ID_MOUSE, report, sizeof(report));
+bool HIDComposite::send_mouse_(int16_t x, int16_t y, int16_t wheel, int16_t pan) {
+  if (!this->initialized_ || !tud_mounted() || !tud_hid_ready()) return false;
+#ifdef USE_HID_COMPOSITE_WIDE_MOUSE
+  // Little-endian 16-bit fields
+  uint8_t report[9] = {this->mouse_buttons_,
+                       (uint8_t) (x & 0xFF), (uint8_t) ((uint16_t) x >> 8),
+                       (uint8_t) (y & 0xFF), (uint8_t) ((uint16_t) y >> 8),
+                       (uint8_t) (wheel & 0xFF), (uint8_t) ((uint16_t) wheel >> 8),
+                       (uint8_t) (pan & 0xFF), (uint8_t) ((uint16_t) pan >> 8)};
+#else
+  uint8_t report[5] = {this->mouse_buttons_, (uint8_t) x, (uint8_t) y, (uint8_t) wheel, (uint8_t) pan};
+#endif
+  if (!tud_hid_report(REPORT_ID_MOUSE, report, sizeof(report))) return false;
+  if (x != 0 || y != 0) this->pointer_absolute_ = false;
+#ifdef USE_HID_COMPOSITE_RECORDING
+  this->record_report_(false, x, y, wheel, pan);
+#endif
+  return true;
+}
+
+// Keep-awake jiggles are not part of a recorded workflow
+bool HIDComposite::send_jiggle_(int16_t x, int16_t y) {
+#ifdef USE_HID_COMPOSITE_RECORDING
+  this->record_skip_ = true;
+  bool sent = this->send_mouse_(x, y, 0, 0);
+  this->record_skip_ = false;
+  return sent;
+#else
+  return this->send_mouse_(x, y, 0, 0);
+#endif
+}
+
+bool HIDComposite::send_absolute_(uint16_t x, uint16_t y) {
+#ifdef USE_HID_COMPOSITE_ABSOLUTE_POINTER
+  if (!this->initialized_ || !tud_mounted() || !tud_hid_ready()) return false;
+  uint8_t report[5] = {this->mouse_buttons_, (uint8_t) (x & 0xFF), (uint8_t) (x >> 8), (uint8_t) (y & 0xFF),
+                       (uint8_t) (y >> 8)};
+  if (!tud_hid_report(REPORT_ID_ABSOLUTE, report, sizeof(report))) return false;
+  this->absolute_x_ = x;
+  this->absolute_y_ = y;
+  this->pointer_absolute_ = true;
+#ifdef USE_HID_COMPOSITE_RECORDING
+  this->record_report_(true, x, y, 0, 0);
+#endif
+  return true;
+#else
+  return false;
+#endif
+}
+
+// Buttons go through the collection that last moved the pointer, so a press,
+// move_absolute, release sequence drags on the absolute pointer
+void HIDComposite::send_mouse_report() { this->send_buttons_(); }
+
+bool HIDComposite::send_buttons_() {
+  if (this->pointer_absolute_) return this->send_absolute_(this->absolute_x_, this->absolute_y_);
+  return this->send_mouse_(0, 0, 0, 0);
+}
+
+void HIDComposite::move_absolute(uint16_t x, uint16_t y) {
+  this->stop_kinetic_scroll();
+#ifdef USE_HID_COMPOSITE_ABSOLUTE_POINTER
+  if (x > ABSOLUTE_MAX) x = ABSOLUTE_MAX;
+  if (y > ABSOLUTE_MAX) y = ABSOLUTE_MAX;
+  if (!this->send_absolute_(x, y)) return;
+  ESP_LOGD(TAG, "Mouse move absolute: x=%u, y=%u", x, y);
+#else
+  ESP_LOGW(TAG, "move_absolute needs absolute_pointer: true");
+#endif
+}
+
+void HIDComposite::move(int16_t x, int16_t y) {
+  this->stop_kinetic_scroll();
+  x = clamp_delta(x);
+  y = clamp_delta(y);
+  if (!this->send_mouse_(x, y, 0, 0)) return;
   ESP_LOGD(TAG, "Mouse move: x=%d, y=%d", x, y);
 }
 
-void HIDComposite::scroll(int8_t vertical, int8_t horizontal) {
-  if (!this->initialized_ || !tud_mounted() || !tud_hid_ready()) return;
-  uint8_t report[5] = {this->mouse_buttons_, 0, 0, (uint8_t)vertical, (uint8_t)horizontal};
-  tud_hid_report(REPORT_ID_MOUSE, report, sizeof(report));
-  ESP_LOGD(TAG, "Mouse scroll: v=%d, h=%d", vertical, horizontal);
+// Scrolling is counted in wheel units: one per detent, or SCROLL_RESOLUTION per
+// detent once the host has enabled the resolution multiplier. Fractions of a
+// unit are kept for the next call and units that do not fit one report are
+// sent in the following frames.
+void HIDComposite::scroll(float vertical, float horizontal) {
+  this->stop_kinetic_scroll();
+  this->scroll_remainder_v_ += vertical * this->wheel_multiplier_;
+  this->scroll_remainder_h_ += horizontal * this->pan_multiplier_;
+  int32_t v = (int32_t) this->scroll_remainder_v_;
+  int32_t h = (int32_t) this->scroll_remainder_h_;
+  this->scroll_remainder_v_ -= v;
+  this->scroll_remainder_h_ -= h;
+  this->scroll_pending_v_ += v;
+  this->scroll_pending_h_ += h;
+  ESP_LOGD(TAG, "Mouse scroll: v=%.2f, h=%.2f (%" PRId32 ", %" PRId32 " units)", vertical, horizontal, v, h);
+  this->flush_scroll_();
 }
 
-void HIDComposite::click(MouseButton button) {
-  this->mouse_press(button);
-  delay(10);
-  this->mouse_release(button);
+// Kinetic scroll integrates a decaying velocity in fixed KINETIC_FRAME_MS steps:
+// each step adds the velocity to a 16.16 position, queues its whole units as
+// pending scroll and multiplies the velocity by the per-step decay factor.
+void HIDComposite::kinetic_scroll(float vertical, float horizontal, float friction) {
+  this->stop_kinetic_scroll();
+  float frames_per_second = 1000.0f / KINETIC_FRAME_MS;
+  this->kinetic_velocity_v_ = (int32_t) lroundf(vertical * this->wheel_multiplier_ / frames_per_second * 65536.0f);
+  this->kinetic_velocity_h_ = (int32_t) lroundf(horizontal * this->pan_multiplier_ / frames_per_second * 65536.0f);
+  this->kinetic_decay_ = (uint32_t) lroundf(expf(-friction / frames_per_second) * 65536.0f);
+  this->kinetic_position_v_ = 0;
+  this->kinetic_position_h_ = 0;
+  this->kinetic_last_ = millis();
+  this->kinetic_active_ = true;
+  this->kinetic_high_freq_.start();
+  ESP_LOGD(TAG, "Kinetic scroll: v=%.1f, h=%.1f detents/s, friction=%.2f", vertical, horizontal, friction);
+}
+
+void HIDComposite::stop_kinetic_scroll() {
+  if (!this->kinetic_active_) return;
+  this->kinetic_active_ = false;
+  this->kinetic_high_freq_.stop();
+}
+
+void HIDComposite::process_kinetic_() {
+  if (!this->kinetic_active_) return;
+  while (millis() - this->kinetic_last_ >= KINETIC_FRAME_MS) {
+    this->kinetic_last_ += KINETIC_FRAME_MS;
+    this->kinetic_position_v_ += this->kinetic_velocity_v_;
+    this->kinetic_position_h_ += this->kinetic_velocity_h_;
+    // Whole units, rounded toward zero; the fraction stays in the position
+    int32_t v = this->kinetic_position_v_ / 65536;
+    int32_t h = this->kinetic_position_h_ / 65536;
+    this->kinetic_position_v_ -= v * 65536;
+    this->kinetic_position_h_ -= h * 65536;
+    this->scroll_pending_v_ += v;
+    this->scroll_pending_h_ += h;
+    this->kinetic_velocity_v_ = (int32_t) (((int64_t) this->kinetic_velocity_v_ * this->kinetic_decay_) >> 16);
+    this->kinetic_velocity_h_ = (int32_t) (((int64_t) this->kinetic_velocity_h_ * this->kinetic_decay_) >> 16);
+    // Stop below one detent per second
+    int32_t floor_v = (int32_t) this->wheel_multiplier_ * 65536 / (1000 / KINETIC_FRAME_MS);
+    int32_t floor_h = (int32_t) this->pan_multiplier_ * 65536 / (1000 / KINETIC_FRAME_MS);
+    if (std::abs(this->kinetic_velocity_v_) < floor_v && std::abs(this->kinetic_velocity_h_) < floor_h) {
+      ESP_LOGV(TAG, "Kinetic scroll settled");
+      this->stop_kinetic_scroll();
+      break;
+    }
+  }
+}
+
+void HIDComposite::flush_scroll_() {
+  if (this->scroll_pending_v_ == 0 && this->scroll_pending_h_ == 0) return;
+  int16_t v = clamp_delta(this->scroll_pending_v_);
+  int16_t h = clamp_delta(this->scroll_pending_h_);
+  if (!this->send_mouse_(0, 0, v, h)) return;
+  this->scroll_pending_v_ -= v;
+  this->scroll_pending_h_ -= h;
+}
+
+// Feature report of the mouse: wheel multiplier in bits 0-1, AC Pan in bits 2-3.
+// Both callbacks run on the USB task, so they only touch scroll_feature_; loop()
+// applies it through apply_scroll_feature_().
+uint16_t HIDComposite::get_feature_report(uint8_t report_id, uint8_t *buffer, uint16_t reqlen) {
+#ifdef USE_HID_COMPOSITE_HIRES_SCROLL
+  if (report_id != REPORT_ID_MOUSE || reqlen < 1) return 0;
+  uint8_t feature = this->scroll_feature_;
+  buffer[0] = ((feature & 0x03) ? 0x01 : 0) | ((feature & 0x0C) ? 0x04 : 0);
+  return 1;
+#else
+  return 0;
+#endif
+}
+
+void HIDComposite::process_feature_report(uint8_t report_id, uint8_t const *buffer, uint16_t bufsize) {
+#ifdef USE_HID_COMPOSITE_HIRES_SCROLL
+  if (report_id != REPORT_ID_MOUSE || bufsize < 1) return;
+  this->scroll_feature_ = buffer[0];
+#endif
+}
+
+void HIDComposite::apply_scroll_feature_() {
+#ifdef USE_HID_COMPOSITE_HIRES_SCROLL
+  uint8_t feature = this->scroll_feature_;
+  uint8_t wheel = (feature & 0x03) ? SCROLL_RESOLUTION : 1;
+  uint8_t pan = (feature & 0x0C) ? SCROLL_RESOLUTION : 1;
+  if (wheel == this->wheel_multiplier_ && pan == this->pan_multiplier_) return;
+  // Pending units were counted at the old resolution
+  this->wheel_multiplier_ = wheel;
+  this->pan_multiplier_ = pan;
+  this->scroll_pending_v_ = this->scroll_pending_h_ = 0;
+  this->scroll_remainder_v_ = this->scroll_remainder_h_ = 0;
+  ESP_LOGI(TAG, "Scroll resolution: wheel x%u, pan x%u", wheel, pan);
+#endif
+}
+
+// ============ Pointer paths ============
+//
+// move_path spreads a displacement over a duration along an easing curve. Each
+// time the endpoint is free (once per poll frame) loop() sends the difference
+// between where the curve says the pointer should be and what was already sent,
+// so rounding never accumulates and the path always ends exactly on target.
+
+static float bezier(float u, float p1, float p2) {
+  float v = 1.0f - u;
+  return 3.0f * v * v * u * p1 + 3.0f * v * u * u * p2 + u * u * u;
+}
+
+void HIDComposite::move_path(int32_t x, int32_t y, uint32_t duration_ms, const Easing &easing,
+                             std::function<void()> &&on_done) {
+  this->stop_kinetic_scroll();
+  // A new path takes over from the current one, which counts as done
+  if (this->path_active_) this->finish_path_();
+  for (uint8_t i = 0; i <= PATH_CURVE_STEPS; i++) {
+    float u = (float) i / PATH_CURVE_STEPS;
+    this->path_curve_x_[i] = (uint32_t) lroundf(bezier(u, easing.x1, easing.x2) * 65536.0f);
+    this->path_curve_y_[i] = (int32_t) lroundf(bezier(u, easing.y1, easing.y2) * 65536.0f);
+  }
+  this->path_x_ = x;
+  this->path_y_ = y;
+  this->path_sent_x_ = 0;
+  this->path_sent_y_ = 0;
+  this->path_start_ = millis();
+  this->path_duration_ = duration_ms;
+  this->path_done_ = std::move(on_done);
+  this->path_active_ = true;
+  this->path_high_freq_.start();
+  ESP_LOGD(TAG, "Mouse path: x=%" PRId32 ", y=%" PRId32 " over %" PRIu32 "ms", x, y, duration_ms);
+}
+
+void HIDComposite::stop_move_path() {
+  if (!this->path_active_) return;
+  this->path_done_ = nullptr;
+  this->finish_path_();
+}
+
+void HIDComposite::finish_path_() {
+  this->path_active_ = false;
+  this->path_high_freq_.stop();
+  auto on_done = std::move(this->path_done_);
+  this->path_done_ = nullptr;
+  if (on_done) on_done();
+}
+
+// Progress (16.16) at time t (16.16 fraction of the duration)
+int32_t HIDComposite::path_progress_(uint32_t t) const {
+  uint8_t lo = 0, hi = PATH_CURVE_STEPS;
+  while (hi - lo > 1) {
+    uint8_t mid = (lo + hi) / 2;
+    if (this->path_curve_x_[mid] <= t) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  uint32_t span = this->path_curve_x_[hi] - this->path_curve_x_[lo];
+  if (span == 0 || t <= this->path_curve_x_[lo]) return this->path_curve_y_[lo];
+  int64_t rise = (int64_t) this->path_curve_y_[hi] - this->path_curve_y_[lo];
+  return this->path_curve_y_[lo] + (int32_t) (rise * (int64_t) (t - this->path_curve_x_[lo]) / span);
+}
+
+void HIDComposite::process_path_() {
+  if (!this->path_active_) return;
+  if (!this->is_connected()) {
+    ESP_LOGW(TAG, "Host disconnected, mouse path aborted");
+    this->finish_path_();
+    return;
+  }
+  if (!tud_hid_ready()) return;
+  uint32_t elapsed = millis() - this->path_start_;
+  int32_t progress = 65536;
+  if (elapsed < this->path_duration_) {
+    progress = this->path_progress_((uint32_t) (((uint64_t) elapsed << 16) / this->path_duration_));
+  }
+  int16_t dx = clamp_delta((int32_t) (((int64_t) this->path_x_ * progress) >> 16) - this->path_sent_x_);
+  int16_t dy = clamp_delta((int32_t) (((int64_t) this->path_y_ * progress) >> 16) - this->path_sent_y_);
+  if ((dx != 0 || dy != 0) && this->send_mouse_(dx, dy, 0, 0)) {
+    this->path_sent_x_ += dx;
+    this->path_sent_y_ += dy;
+  }
+  // Past the duration, frames keep going until deltas clamped to MOUSE_DELTA_MAX catch up
+  if (elapsed >= this->path_duration_ && this->path_sent_x_ == this->path_x_ && this->path_sent_y_ == this->path_y_) {
+    this->finish_path_();
+  }
+}
+
+#ifdef USE_HID_COMPOSITE_BALLISTICS
+// ============ Pixel moves ============
+//
+// Hosts with pointer acceleration scale each report by a gain that grows with
+// its speed, so the same counts travel further when sent in fewer, larger
+// reports. move_pixels keeps the pixels still to travel; each frame it finds
+// how many reports the rest needs at the largest report the curve allows,
+// sizes this report to cover an even share, and takes away what the curve says
+// the host will move. The host keeps sub-pixel remainders, so the rest is
+// tracked in fractions too and the pointer lands within half a pixel.
+
+static float speed_magnitude(float x, float y) {
+  x = fabsf(x);
+  y = fabsf(y);
+  return x > y ? x + y / 2 : y + x / 2;
+}
+
+void HIDComposite::add_ballistics_point(float counts, float pixels) {
+  if (this->ballistics_count_ < BALLISTICS_MAX_POINTS) this->ballistics_[this->ballistics_count_++] = {counts, pixels};
+}
+
+// Pixels the host moves for a report of this speed magnitude
+float HIDComposite::ballistics_pixels_(float counts) const {
+  uint8_t i = 1;
+  while (i + 1 < this->ballistics_count_ && counts > this->ballistics_[i].counts) i++;
+  const BallisticsPoint &a = this->ballistics_[i - 1];
+  const BallisticsPoint &b = this->ballistics_[i];
+  // The codegen only passes increasing points; a flat segment is a step
+  float span = b.counts - a.counts;
+  if (span <= 0) return b.pixels;
+  return a.pixels + (counts - a.counts) * (b.pixels - a.pixels) / span;
+}
+
+// Speed magnitude of the report that moves the host this many pixels
+float HIDComposite::ballistics_counts_(float pixels) const {
+  uint8_t i = 1;
+  while (i + 1 < this->ballistics_count_ && pixels > this->ballistics_[i].pixels) i++;
+  const BallisticsPoint &a = this->ballistics_[i - 1];
+  const BallisticsPoint &b = this->ballistics_[i];
+  float span = b.pixels - a.pixels;
+  if (span <= 0) return b.counts;
+  return a.counts + (pixels - a.pixels) * (b.counts - a.counts) / span;
+}
+
+void HIDComposite::move_pixels(int32_t x, int32_t y, std::function<void()> &&on_done) {
+  this->stop_kinetic_scroll();
+  // A new move takes over from the current one, which counts as done
+  if (this->pixels_active_) this->finish_pixels_();
+  this->pixels_remaining_x_ = x;
+  this->pixels_remaining_y_ = y;
+  this->pixels_done_ = std::move(on_done);
+  this->pixels_active_ = true;
+  this->pixels_high_freq_.start();
+  ESP_LOGD(TAG, "Mouse move pixels: x=%" PRId32 ", y=%" PRId32, x, y);
+}
+
+void HIDComposite::stop_move_pixels() {
+  if (!this->pixels_active_) return;
+  this->pixels_done_ = nullptr;
+  this->finish_pixels_();
+}
+
+void HIDComposite::finish_pixels_() {
+  this->pixels_active_ = false;
+  this->pixels_high_freq_.stop();
+  auto on_done = std::move(this->pixels_done_);
+  this->pixels_done_ = nullptr;
+  if (on_done) on_done();
+}
+
+void HIDComposite::process_pixels_() {
+  if (!this->pixels_active_) return;
+  if (!this->is_connected()) {
+    ESP_LOGW(TAG, "Host disconnected, pixel move aborted");
+    this->finish_pixels_();
+    return;
+  }
+  if (!tud_hid_ready()) return;
+  float rx = this->pixels_remaining_x_;
+  float ry = this->pixels_remaining_y_;
+  float distance = speed_magnitude(rx, ry);
+  if (distance < 0.5f || this->ballistics_count_ < 2) {
+    this->finish_pixels_();
+    return;
+  }
+  // The gain scales both axes alike, so pixel and count vectors share a
+  // direction and the magnitude maps through the curve
+  float widest = MOUSE_DELTA_MAX / fmaxf(fabsf(rx), fabsf(ry));
+  float reach = this->ballistics_pixels_(speed_magnitude(rx * widest, ry * widest));
+  if (reach <= 0) {
+    ESP_LOGW(TAG, "Pointer ballistics curve moves no pixels, pixel move aborted");
+    this->finish_pixels_();
+    return;
+  }
+  float reports = ceilf(distance / reach);
+  float counts = this->ballistics_counts_(distance / reports);
+  int16_t dx = clamp_delta(lroundf(rx * counts / distance));
+  int16_t dy = clamp_delta(lroundf(ry * counts / distance));
+  float magnitude = speed_magnitude(dx, dy);
+  float gain = magnitude > 0 ? this->ballistics_pixels_(magnitude) / magnitude : 0;
+  float next_x = rx - dx * gain;
+  float next_y = ry - dy * gain;
+  // Left over is less than the smallest report would overshoot by
+  if (magnitude == 0 || speed_magnitude(next_x, next_y) >= distance) {
+    this->finish_pixels_();
+    return;
+  }
+  if (!this->send_mouse_(dx, dy, 0, 0)) return;
+  this->pixels_remaining_x_ = next_x;
+  this->pixels_remaining_y_ = next_y;
+}
+#endif
+
+#ifdef USE_HID_COMPOSITE_RECORDING
+// ============ Recording and replay ============
+//
+// Every mouse report sent while recording is captured with its timing. Moves
+// and scroll are already deltas; buttons and the interval are stored only when
+// they change, and runs of identical reports (steady motion) collapse into one
+// with a repeat count. Reports less than a millisecond apart in timing count as
+// identical.
+
+static const char *const RECORDING_KEY_PREFIX = "hid_composite_recording:";
+
+static uint32_t recording_key(const std::string &name) { return fnv1_hash(RECORDING_KEY_PREFIX + name); }
+
+static uint8_t put_varint(uint8_t *out, uint32_t value) {
+  uint8_t n = 0;
+  while (value >= 0x80) {
+    out[n++] = (uint8_t) (value | 0x80);
+    value >>= 7;
+  }
+  out[n++] = (uint8_t) value;
+  return n;
+}
+
+static uint32_t zigzag(int32_t value) { return ((uint32_t) value << 1) ^ (uint32_t) (value >> 31); }
+static int32_t unzigzag(uint32_t value) { return (int32_t) (value >> 1) ^ -(int32_t) (value & 1); }
+
+static bool get_varint(const MouseRecording &rec, size_t &pos, uint32_t &value) {
+  value = 0;
+  for (uint8_t shift = 0; shift < 35; shift += 7) {
+    if (pos >= rec.length) return false;
+    uint8_t b = rec.data[pos++];
+    value |= (uint32_t) (b & 0x7F) << shift;
+    if (!(b & 0x80)) return true;
+  }
+  return false;
+}
+
+void HIDComposite::start_recording(const std::string &name) {
+  if (this->recording_) ESP_LOGW(TAG, "Recording '%s' discarded", this->record_name_.c_str());
+  this->record_name_ = name;
+  this->record_buffer_.clear();
+  this->record_buffer_.reserve(HID_COMPOSITE_RECORDING_SIZE);
+  this->record_has_pending_ = false;
+  this->record_last_ = millis();
+  this->record_buttons_ = 0;
+  this->record_dt_ = 0;
+  this->recording_ = true;
+  ESP_LOGI(TAG, "Recording '%s'", name.c_str());
+}
+
+void HIDComposite::stop_recording() {
+  if (!this->recording_) return;
+  this->record_flush_();
+  this->recording_ = false;
+  auto rec = std::make_unique<MouseRecording>();
+  rec->length = this->record_buffer_.size();
+  memcpy(rec->data, this->record_buffer_.data(), rec->length);
+  auto pref = global_preferences->make_preference<MouseRecording>(recording_key(this->record_name_), true);
+  bool saved = pref.save(rec.get()) && global_preferences->sync();
+  ESP_LOGI(TAG, "Recording '%s': %u of %u bytes%s", this->record_name_.c_str(), rec->length,
+           (unsigned) HID_COMPOSITE_RECORDING_SIZE, saved ? "" : ", save failed");
+  this->record_buffer_.clear();
+  this->record_buffer_.shrink_to_fit();
+}
+
+void HIDComposite::record_report_(bool absolute, int32_t x, int32_t y, int32_t wheel, int32_t pan) {
+  // A skipped report's time is carried into the next recorded one's delay
+  if (!this->recording_ || this->record_skip_) return;
+  uint32_t now = millis();
+  RecordedReport report{absolute, this->mouse_buttons_, x, y, wheel, pan, now - this->record_last_, 0};
+  this->record_last_ = now;
+  RecordedReport &last = this->record_pending_;
+  if (this->record_has_pending_ && last.absolute == absolute && last.buttons == report.buttons && last.x == x &&
+      last.y == y && last.wheel == wheel && last.pan == pan && report.dt + 1 >= last.dt && report.dt <= last.dt + 1) {
+    last.repeat++;
+    return;
+  }
+  if (this->record_has_pending_ && !this->record_flush_()) return;
+  this->record_pending_ = report;
+  this->record_has_pending_ = true;
+}
+
+// Encodes the pending report; a full buffer ends the recording
+bool HIDComposite::record_flush_() {
+  if (!this->record_has_pending_) return true;
+  const RecordedReport &r = this->record_pending_;
+  uint8_t out[1 + 1 + 6 * 5];
+  uint8_t n = 1;
+  uint8_t flags = 0;
+  if (r.buttons != this->record_buttons_) {
+    flags |= RECORD_BUTTONS;
+    out[n++] = r.buttons;
+  }
+  if (r.absolute) {
+    flags |= RECORD_ABSOLUTE;
+    n += put_varint(out + n, r.x);
+    n += put_varint(out + n, r.y);
+  } else if (r.x != 0 || r.y != 0) {
+    flags |= RECORD_MOVE;
+    n += put_varint(out + n, zigzag(r.x));
+    n += put_varint(out + n, zigzag(r.y));
+  }
+  if (r.wheel != 0 || r.pan != 0) {
+    flags |= RECORD_SCROLL;
+    n += put_varint(out + n, zigzag(r.wheel));
+    n += put_varint(out + n, zigzag(r.pan));
+  }
+  if (r.dt != this->record_dt_) {
+    flags |= RECORD_TIME;
+    n += put_varint(out + n, r.dt);
+  }
+  if (r.repeat > 0) {
+    flags |= RECORD_REPEAT;
+    n += put_varint(out + n, r.repeat);
+  }
+  out[0] = flags;
+  if (this->record_buffer_.size() + n > HID_COMPOSITE_RECORDING_SIZE) {
+    ESP_LOGW(TAG, "Recording '%s' full, stopped", this->record_name_.c_str());
+    this->record_has_pending_ = false;
+    this->stop_recording();
+    return false;
+  }
+  this->record_buffer_.insert(this->record_buffer_.end(), out, out + n);
+  this->record_buttons_ = r.buttons;
+  this->record_dt_ = r.dt;
+  this->record_has_pending_ = false;
+  return true;
+}
+
+void HIDComposite::replay(const std::string &name, std::function<void()> &&on_done) {
+  // A new replay takes over from the current one, which counts as done
+  if (this->replay_active_) this->finish_replay_();
+  auto rec = std::make_unique<MouseRecording>();
+  auto pref = global_preferences->make_preference<MouseRecording>(recording_key(name), true);
+  if (!pref.load(rec.get()) || rec->length > HID_COMPOSITE_RECORDING_SIZE) {
+    ESP_LOGW(TAG, "No recording '%s'", name.c_str());
+    if (on_done) on_done();
+    return;
+  }
+  this->replay_data_ = std::move(rec);
+  this->replay_pos_ = 0;
+  this->replay_report_ = {};
+  this->replay_done_ = std::move(on_done);
+  this->replay_active_ = true;
+  if (!this->replay_decode_()) {
+    this->finish_replay_();
+    return;
+  }
+  this->replay_due_ = millis() + this->replay_report_.dt;
+  this->replay_high_freq_.start();
+  ESP_LOGI(TAG, "Replaying '%s' (%u bytes)", name.c_str(), this->replay_data_->length);
+}
+
+void HIDComposite::stop_replay() {
+  if (!this->replay_active_) return;
+  this->replay_done_ = nullptr;
+  this->finish_replay_();
+}
+
+void HIDComposite::finish_replay_() {
+  this->replay_active_ = false;
+  this->replay_high_freq_.stop();
+  this->replay_data_.reset();
+  // Do not leave a button held if the recording was cut short
+  if (this->mouse_buttons_ != 0) {
+    this->mouse_buttons_ = 0;
+    this->send_mouse_report();
+  }
+  auto on_done = std::move(this->replay_done_);
+  this->replay_done_ = nullptr;
+  if (on_done) on_done();
+}
+
+// Decodes the next report into replay_report_; buttons and the interval carry
+// over from the previous one unless flagged
+bool HIDComposite::replay_decode_() {
+  const MouseRecording &rec = *this->replay_data_;
+  RecordedReport &r = this->replay_report_;
+  if (this->replay_pos_ >= rec.length) return false;
+  uint8_t flags = rec.data[this->replay_pos_++];
+  uint32_t a = 0, b = 0;
+  if (flags & RECORD_BUTTONS) {
+    if (this->replay_pos_ >= rec.length) return false;
+    r.buttons = rec.data[this->replay_pos_++];
+  }
+  r.absolute = flags & RECORD_ABSOLUTE;
+  r.x = r.y = r.wheel = r.pan = 0;
+  if (flags & (RECORD_ABSOLUTE | RECORD_MOVE)) {
+    if (!get_varint(rec, this->replay_pos_, a) || !get_varint(rec, this->replay_pos_, b)) return false;
+    r.x = r.absolute ? (int32_t) a : unzigzag(a);
+    r.y = r.absolute ? (int32_t) b : unzigzag(b);
+  }
+  if (flags & RECORD_SCROLL) {
+    if (!get_varint(rec, this->replay_pos_, a) || !get_varint(rec, this->replay_pos_, b)) return false;
+    r.wheel = unzigzag(a);
+    r.pan = unzigzag(b);
+  }
+  if ((flags & RECORD_TIME) && !get_varint(rec, this->replay_pos_, r.dt)) return false;
+  r.repeat = 0;
+  if ((flags & RECORD_REPEAT) && !get_varint(rec, this->replay_pos_, r.repeat)) return false;
+  return true;
+}
+
+void HIDComposite::process_replay_() {
+  if (!this->replay_active_) return;
+  if (!this->is_connected()) {
+    ESP_LOGW(TAG, "Host disconnected, replay aborted");
+    this->finish_replay_();
+    return;
+  }
+  // Due times follow the recorded intervals, so a late frame does not shift the rest
+  if ((int32_t) (millis() - this->replay_due_) < 0 || !tud_hid_ready()) return;
+  const RecordedReport &r = this->replay_report_;
+  this->mouse_buttons_ = r.buttons;
+  // A report the endpoint refuses (or an absolute one without absolute_pointer)
+  // is dropped rather than retried, so the replay keeps its pace
+  if (r.absolute) {
+    this->send_absolute_(r.x, r.y);
+  } else {
+    this->send_mouse_(r.x, r.y, r.wheel, r.pan);
+  }
+  if (this->replay_report_.repeat > 0) {
+    this->replay_report_.repeat--;
+  } else if (!this->replay_decode_()) {
+    this->finish_replay_();
+    return;
+  }
+  this->replay_due_ += this->replay_report_.dt;
+}
+#endif
+
+// ============ Gestures ============
+//
+// Gestures are queued whole, so the steps of one gesture are never interleaved
+// with another gesture or a keep-awake jiggle. A step starts once its button
+// change has been accepted by the endpoint; the hold is timed from there.
+
+static const Easing GESTURE_EASING{0.42f, 0.0f, 0.58f, 1.0f};
+
+void HIDComposite::click(MouseButton button, std::function<void()> &&on_done) {
+  uint8_t mask = 1 << button;
+  this->queue_gesture_({{mask, 0, 0, 0, CLICK_HOLD_MS}, {0, mask, 0, 0, 0}}, std::move(on_done));
+  ESP_LOGD(TAG, "Mouse click: button=%d", button);
+}
+
+void HIDComposite::double_click(MouseButton button, uint32_t interval_ms, std::function<void()> &&on_done) {
+  uint8_t mask = 1 << button;
+  this->queue_gesture_({{mask, 0, 0, 0, CLICK_HOLD_MS},
+                        {0, mask, 0, 0, interval_ms},
+                        {mask, 0, 0, 0, CLICK_HOLD_MS},
+                        {0, mask, 0, 0, 0}},
+                       std::move(on_done));
+  ESP_LOGD(TAG, "Mouse double click: button=%d, interval=%" PRIu32 "ms", button, interval_ms);
+}
+
+void HIDComposite::drag(MouseButton button, int32_t x, int32_t y, uint32_t duration_ms,
+                        std::function<void()> &&on_done) {
+  uint8_t mask = 1 << button;
+  this->queue_gesture_({{mask, 0, 0, 0, DRAG_HOLD_MS},
+                        {0, 0, x, y, duration_ms},
+                        {0, 0, 0, 0, DRAG_HOLD_MS},
+                        {0, mask, 0, 0, 0}},
+                       std::move(on_done));
+  ESP_LOGD(TAG, "Mouse drag: button=%d, x=%" PRId32 ", y=%" PRId32 " over %" PRIu32 "ms", button, x, y,
+           duration_ms);
+}
+
+void HIDComposite::stop_gestures() { this->finish_gestures_(false); }
+
+void HIDComposite::queue_gesture_(std::initializer_list<GestureStep> steps, std::function<void()> &&on_done) {
+  if (this->gesture_count_ + steps.size() > GESTURE_QUEUE_SIZE) {
+    ESP_LOGW(TAG, "Gesture queue full, gesture dropped");
+    if (on_done) on_done();
+    return;
+  }
+  uint8_t index = 0;
+  for (const GestureStep &step : steps) {
+    index = (this->gesture_head_ + this->gesture_count_++) % GESTURE_QUEUE_SIZE;
+    this->gesture_steps_[index] = step;
+  }
+  this->gesture_steps_[index].on_done = std::move(on_done);
+  this->gesture_high_freq_.start();
+}
+
+void HIDComposite::process_gesture_() {
+  if (this->gesture_count_ == 0) return;
+  if (!this->is_connected()) {
+    ESP_LOGW(TAG, "Host disconnected, mouse gestures aborted");
+    this->finish_gestures_(true);
+    return;
+  }
+  GestureStep &step = this->gesture_steps_[this->gesture_head_];
+  bool moves = step.x != 0 || step.y != 0;
+  if (!this->gesture_step_started_) {
+    if (step.press != 0 || step.release != 0) {
+      uint8_t buttons = this->mouse_buttons_;
+      this->mouse_buttons_ = (buttons | step.press) & ~step.release;
+      // Endpoint busy: try again on the next loop
+      if (!this->send_buttons_()) {
+        this->mouse_buttons_ = buttons;
+        return;
+      }
+      this->gesture_buttons_ = (this->gesture_buttons_ | step.press) & ~step.release;
+    }
+    if (moves) this->move_path(step.x, step.y, step.duration_ms, GESTURE_EASING);
+    this->gesture_step_started_ = true;
+    this->gesture_step_start_ = millis();
+    return;
+  }
+  if (moves ? this->path_active_ : millis() - this->gesture_step_start_ < step.duration_ms) return;
+
+  auto on_done = std::move(step.on_done);
+  step.on_done = nullptr;
+  this->gesture_head_ = (this->gesture_head_ + 1) % GESTURE_QUEUE_SIZE;
+  this->gesture_count_--;
+  this->gesture_step_started_ = false;
+  if (this->gesture_count_ == 0) this->gesture_high_freq_.stop();
+  if (on_done) on_done();
+}
+
+void HIDComposite::finish_gestures_(bool notify) {
+  if (this->gesture_count_ == 0) return;
+  const GestureStep &current = this->gesture_steps_[this->gesture_head_];
+  if (this->gesture_step_started_ && (current.x != 0 || current.y != 0)) this->stop_move_path();
+  std::vector<std::function<void()>> callbacks;
+  while (this->gesture_count_ > 0) {
+    GestureStep &step = this->gesture_steps_[this->gesture_head_];
+    if (notify && step.on_done) callbacks.push_back(std::move(step.on_done));
+    step.on_done = nullptr;
+    this->gesture_head_ = (this->gesture_head_ + 1) % GESTURE_QUEUE_SIZE;
+    this->gesture_count_--;
+  }
+  this->gesture_step_started_ = false;
+  this->gesture_high_freq_.stop();
+  if (this->gesture_buttons_ != 0) {
+    this->mouse_buttons_ &= ~this->gesture_buttons_;
+    this->gesture_buttons_ = 0;
+    this->send_mouse_report();
+  }
+  for (auto &callback : callbacks) callback();
 }
 
 void HIDComposite::mouse_press(MouseButton button) {
@@ -401,55 +1344,837 @@ void HIDComposite::mouse_release_all() {
 // ============ Keyboard Functions ============
 
 void HIDComposite::send_keyboard_report(uint8_t modifier, uint8_t keycode) {
+  this->send_keyboard_report(modifier, &keycode, keycode == KEY_NONE ? 0 : 1);
+}
+
+void HIDComposite::send_keyboard_report(uint8_t modifier, const uint8_t *keycodes, uint8_t count) {
   if (!this->initialized_ || !tud_mounted() || !tud_hid_ready()) return;
-  uint8_t report[8] = {modifier, 0, keycode, 0, 0, 0, 0, 0};
+  uint8_t report[KEYBOARD_REPORT_SIZE] = {modifier};
+#ifdef USE_HID_COMPOSITE_NKRO
+  for (uint8_t i = 0; i < count; i++) {
+    uint8_t key = keycodes[i];
+    if (key < KEY_LEFT_CTRL) report[1 + (key >> 3)] |= 1 << (key & 7);
+  }
+#else
+  for (uint8_t i = 0; i < count && i < KEYBOARD_ROLLOVER; i++) report[2 + i] = keycodes[i];
+#endif
   tud_hid_report(REPORT_ID_KEYBOARD, report, sizeof(report));
-  ESP_LOGD(TAG, "Keyboard report: mod=0x%02X key=0x%02X", modifier, keycode);
+  ESP_LOGV(TAG, "Keyboard report: mod=0x%02X keys=%d first=0x%02X", modifier, count, count ? keycodes[0] : 0);
 }
 
-void HIDComposite::key_press(const std::string &key, uint8_t modifier) {
-  uint8_t keycode, char_mod;
+uint8_t HIDComposite::resolve_key_(const std::string &key, uint8_t &modifier) {
+  uint8_t keycode;
   if (key.length() == 1) {
-    this->char_to_keycode(key[0], keycode, char_mod);
+    this->char_to_keycode(key[0], keycode, modifier);
   } else {
     keycode = this->key_name_to_keycode(key);
-    char_mod = 0;
+    modifier = 0;
+  }
+  return keycode;
+}
+
+// Pressed-key state. Each held key keeps the modifier it was pressed with (e.g. the
+// implied Shift of 'A'), so releasing it drops that modifier too; modifier keys
+// pressed on their own (LEFT_CTRL..RIGHT_GUI) live in held_modifiers_. Every report
+// is rebuilt from this set, so overlapping presses and releases are preserved.
+bool HIDComposite::hold_usage_(uint8_t usage, uint8_t modifier) {
+  if (usage >= KEY_LEFT_CTRL && usage <= KEY_RIGHT_GUI) {
+    this->held_modifiers_ |= modifier | (1 << (usage - KEY_LEFT_CTRL));
+    return true;
+  }
+  if (usage == KEY_NONE) {
+    this->held_modifiers_ |= modifier;
+    return true;
+  }
+  for (uint8_t i = 0; i < this->held_count_; i++) {
+    if (this->held_keys_[i] == usage) {
+      this->held_key_mods_[i] = modifier;
+      return true;
+    }
+  }
+  if (this->held_count_ == KEYBOARD_ROLLOVER) {
+    ESP_LOGW(TAG, "Cannot hold key 0x%02X: %d keys already pressed", usage, KEYBOARD_ROLLOVER);
+    return false;
+  }
+  this->held_keys_[this->held_count_] = usage;
+  this->held_key_mods_[this->held_count_] = modifier;
+  this->held_count_++;
+  return true;
+}
+
+void HIDComposite::drop_usage_(uint8_t usage, uint8_t modifier) {
+  if (usage >= KEY_LEFT_CTRL && usage <= KEY_RIGHT_GUI) {
+    this->held_modifiers_ &= ~(modifier | (1 << (usage - KEY_LEFT_CTRL)));
+    return;
+  }
+  if (usage == KEY_NONE) {
+    this->held_modifiers_ &= ~modifier;
+    return;
+  }
+  for (uint8_t i = 0; i < this->held_count_; i++) {
+    if (this->held_keys_[i] != usage) continue;
+    // Keep press order for the remaining keys
+    for (uint8_t j = i + 1; j < this->held_count_; j++) {
+      this->held_keys_[j - 1] = this->held_keys_[j];
+      this->held_key_mods_[j - 1] = this->held_key_mods_[j];
+    }
+    this->held_count_--;
+    return;
   }
+}
+
+void HIDComposite::send_held_keys_() {
+  uint8_t modifier = this->held_modifiers_;
+  for (uint8_t i = 0; i < this->held_count_; i++) modifier |= this->held_key_mods_[i];
+  this->send_keyboard_report(modifier, this->held_keys_, this->held_count_);
+}
+
+void HIDComposite::key_press(const std::string &key, uint8_t modifier) {
+  uint8_t char_mod;
+  uint8_t keycode = this->resolve_key_(key, char_mod);
   ESP_LOGD(TAG, "Key press: %s", key.c_str());
-  this->send_keyboard_report(modifier | char_mod, keycode);
+  this->press_usage(keycode, modifier | char_mod);
+}
+
+void HIDComposite::press_usage(uint8_t usage, uint8_t modifier) {
+  if (this->hold_usage_(usage, modifier)) this->send_held_keys_();
+}
+
+void HIDComposite::key_release(const std::string &key) {
+  uint8_t char_mod;
+  uint8_t keycode = this->resolve_key_(key, char_mod);
+  ESP_LOGD(TAG, "Key release: %s", key.c_str());
+  this->release_usage(keycode, char_mod);
+}
+
+void HIDComposite::release_usage(uint8_t usage, uint8_t modifier) {
+  this->drop_usage_(usage, modifier);
+  this->send_held_keys_();
 }
 
 void HIDComposite::key_release() { this->key_release_all(); }
 void HIDComposite::key_release_all() {
   ESP_LOGD(TAG, "Key release all");
+  this->cancel_timeout("key_release");
+  this->tap_release_.clear();
+  this->held_modifiers_ = 0;
+  this->held_count_ = 0;
   this->send_keyboard_report(0, 0);
 }
 
 void HIDComposite::key_tap(const std::string &key, uint8_t modifier) {
-  this->key_press(key, modifier);
-  delay(10);
-  this->key_release();
+  uint8_t char_mod;
+  uint8_t keycode = this->resolve_key_(key, char_mod);
+  ESP_LOGD(TAG, "Key tap: %s", key.c_str());
+  this->tap_usage(keycode, modifier | char_mod);
+}
+
+void HIDComposite::tap_usage(uint8_t usage, uint8_t modifier) {
+  // A key still down from an earlier tap is released first, so the host sees a
+  // second keystroke
+  for (const auto &key : this->tap_release_) {
+    if (key.first == usage && usage != KEY_NONE) {
+      this->release_taps_();
+      break;
+    }
+  }
+  if (!this->hold_usage_(usage, modifier)) return;
+  this->send_held_keys_();
+  this->tap_release_.emplace_back(usage, modifier);
+  this->schedule_tap_release_(10);
+}
+
+void HIDComposite::schedule_tap_release_(uint32_t delay_ms) {
+  this->set_timeout("key_release", delay_ms, [this]() {
+    // A dropped release would leave the keys down: wait for the endpoint
+    if (tud_mounted() && !tud_hid_ready()) {
+      this->schedule_tap_release_(1);
+      return;
+    }
+    this->release_taps_();
+  });
+}
+
+void HIDComposite::release_taps_() {
+  this->cancel_timeout("key_release");
+  if (this->tap_release_.empty()) return;
+  for (const auto &key : this->tap_release_) this->drop_usage_(key.first, key.second);
+  this->tap_release_.clear();
+  this->send_held_keys_();
+}
+
+// The whole combination goes out in one report and is released in one report
+// with the pending taps; keys that were already held stay pressed.
+void HIDComposite::chord(const std::vector<uint8_t> &usages, uint8_t modifier) {
+  // Keys of an earlier tap or chord would hide this press from the host
+  this->release_taps_();
+  uint8_t saved_modifiers = this->held_modifiers_;
+  this->held_modifiers_ |= modifier;
+  uint8_t pressed[KEYBOARD_ROLLOVER];
+  uint8_t count = 0;
+  for (uint8_t usage : usages) {
+    // Modifier keys only set bits in the modifier byte: they take no key slot
+    if (usage == KEY_NONE || (usage >= KEY_LEFT_CTRL && usage <= KEY_RIGHT_GUI)) {
+      this->hold_usage_(usage, 0);
+      continue;
+    }
+    bool already = false;
+    for (uint8_t i = 0; i < this->held_count_; i++) {
+      if (this->held_keys_[i] == usage) already = true;
+    }
+    if (!already && this->hold_usage_(usage, 0)) pressed[count++] = usage;
+  }
+  ESP_LOGD(TAG, "Chord: %d keys, mod=0x%02X", (int) usages.size(), modifier);
+  this->send_held_keys_();
+  for (uint8_t i = 0; i < count; i++) this->tap_release_.emplace_back(pressed[i], 0);
+  // Only the modifier bits the chord added are dropped with it
+  this->tap_release_.emplace_back(KEY_NONE, this->held_modifiers_ & ~saved_modifiers);
+  this->schedule_tap_release_(10);
+}
+
+// Keys named as strings (characters typed with a runtime layout) are resolved
+// against the active layout, then sent like a resolved chord.
+void HIDComposite::chord(const std::vector<std::string> &keys, uint8_t modifier) {
+  std::vector<uint8_t> usages;
+  for (const std::string &key : keys) {
+    uint8_t char_mod;
+    uint8_t usage = this->resolve_key_(key, char_mod);
+    modifier |= char_mod;
+    if (usage >= KEY_LEFT_CTRL && usage <= KEY_RIGHT_GUI) {
+      modifier |= 1 << (usage - KEY_LEFT_CTRL);
+    } else if (usage != KEY_NONE) {
+      usages.push_back(usage);
+    }
+  }
+  this->chord(usages, modifier);
+}
+
+// Incremental UTF-8 decoding, so text can arrive in chunks of any size.
+// Stray continuation bytes and invalid lead bytes are skipped; truncated
+// sequences are dropped.
+bool Utf8Decoder::feed(uint8_t byte, uint32_t &codepoint) {
+  if ((byte & 0xC0) == 0x80) {
+    if (this->pending_ == 0) return false;
+    this->codepoint_ = (this->codepoint_ << 6) | (byte & 0x3F);
+    if (--this->pending_ > 0) return false;
+    codepoint = this->codepoint_;
+    return true;
+  }
+  if (byte >= 0xF8) {
+    this->pending_ = 0;
+    return false;
+  }
+  this->pending_ = byte >= 0xF0 ? 3 : byte >= 0xE0 ? 2 : byte >= 0xC0 ? 1 : 0;
+  if (this->pending_ == 0) {
+    codepoint = byte;
+    return true;
+  }
+  this->codepoint_ = byte & (0x3F >> this->pending_);
+  return false;
+}
+
+void HIDComposite::type(const std::string &text, uint32_t speed_ms, uint32_t jitter_ms, bool burst,
+                        UnicodeMode unicode) {
+  ESP_LOGI(TAG, "Type: %s (speed=%dms, jitter=%dms%s)", text.c_str(), speed_ms, jitter_ms, burst ? ", burst" : "");
+  if (burst) {
+    this->type_burst_(text, speed_ms, jitter_ms, unicode);
+    return;
+  }
+  // Translate the whole text before timing starts; the send loop only replays reports
+  std::vector<QueuedReport> reports;
+  this->compile_text_(text, unicode, reports);
+  this->send_reports_(reports.data(), reports.size(), speed_ms, jitter_ms);
+}
+
+void HIDComposite::compile_text_(const std::string &text, UnicodeMode unicode, std::vector<QueuedReport> &out) {
+  out.reserve(text.size() + 8);
+  QueuedReport reports[MAX_REPORTS_PER_CODEPOINT];
+  Utf8Decoder decoder;
+  this->start_text_();
+  size_t skipped = 0;
+  uint32_t first_skipped = 0;
+  for (char c : text) {
+    uint32_t codepoint;
+    if (!decoder.feed(c, codepoint)) continue;
+    uint8_t n = this->compile_codepoint_(codepoint, unicode, reports);
+    if (n == 0) {
+      if (skipped++ == 0) first_skipped = codepoint;
+      continue;
+    }
+    out.insert(out.end(), reports, reports + n);
+  }
+  uint8_t n = this->end_text_(reports);
+  out.insert(out.end(), reports, reports + n);
+  this->report_skipped_(skipped, first_skipped, unicode);
+}
+
+void HIDComposite::report_skipped_(size_t count, uint32_t first, UnicodeMode unicode) {
+  if (count == 0) return;
+  ESP_LOGW(TAG, "%u character(s) cannot be typed with this layout, first U+%04" PRIX32 "%s", (unsigned) count, first,
+           unicode == UNICODE_NONE ? " (set unicode: to enable Unicode entry)" : "");
+}
+
+void HIDComposite::send_reports_(const QueuedReport *reports, size_t count, uint32_t speed_ms, uint32_t jitter_ms) {
+  uint8_t last_key = KEY_NONE;
+  for (size_t i = 0; i < count; i++) {
+    this->send_keyboard_report(reports[i].modifier, reports[i].keycode);
+    if (reports[i].keycode != KEY_NONE) last_key = reports[i].keycode;
+    if (!reports[i].end_of_char) {
+      delay(10);
+      continue;
+    }
+    // The delay depends on the key that follows as well (digraph latency)
+    uint8_t next_key = KEY_NONE;
+    for (size_t j = i + 1; j < count && next_key == KEY_NONE; j++) next_key = reports[j].keycode;
+    uint32_t gap = this->type_delay_(speed_ms, jitter_ms, last_key, next_key);
+    if (reports[i].keycode != KEY_NONE && gap > KEY_HOLD_MAX_MS) {
+      delay(10);
+      this->send_keyboard_report(reports[i].modifier, KEY_NONE);
+      gap -= 10;
+    }
+    delay(gap);
+  }
 }
 
-void HIDComposite::type(const std::string &text, uint32_t speed_ms, uint32_t jitter_ms) {
-  ESP_LOGI(TAG, "Type: %s (speed=%dms, jitter=%dms)", text.c_str(), speed_ms, jitter_ms);
+// Layout lookup adjusted for the host lock state: with Caps Lock on, letters are
+// sent with Shift inverted so the text comes out as written.
+void HIDComposite::layout_keycode_(uint32_t codepoint, uint8_t &keycode, uint8_t &modifier) {
+  keycode = KEY_NONE;
+  modifier = 0;
+  if (codepoint >= 0x80) return;
+  char c = codepoint;
+  this->char_to_keycode(c, keycode, modifier);
+  bool letter = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+  if (letter && (this->keyboard_leds_ & LED_CAPS_LOCK)) modifier ^= MOD_LEFT_SHIFT;
+}
+
+void HIDComposite::start_text_() {
+  this->compile_modifier_ = 0;
+  this->compile_key_ = KEY_NONE;
+}
+
+// Translate one code point into the reports that type it. Returns 0 for
+// characters that cannot be typed.
+//
+// Layout characters are run-length encoded on the modifier: the modifier stays
+// held across consecutive characters that need the same one, and each key
+// replaces the previous one in the key slot, so a run of capitals or symbols
+// costs one report per character. The slot is released in between only for a
+// repeated key, and a modifier change gets its own report before the key.
+// Unicode entry sequences start from an empty report.
+uint8_t HIDComposite::compile_codepoint_(uint32_t codepoint, UnicodeMode unicode, QueuedReport *out) {
+  uint8_t keycode, mod;
+  this->layout_keycode_(codepoint, keycode, mod);
+  if (keycode == KEY_NONE) {
+    bool held = this->compile_modifier_ != 0 || this->compile_key_ != KEY_NONE;
+    uint8_t n = this->unicode_reports_(codepoint, unicode, held ? out + 1 : out);
+    if (n == 0) return 0;
+    if (held) out[0] = {0, KEY_NONE, false};
+    this->start_text_();
+    return held ? n + 1 : n;
+  }
+  uint8_t n = 0;
+  if (mod != this->compile_modifier_ || keycode == this->compile_key_) out[n++] = {mod, KEY_NONE, false};
+  out[n++] = {mod, keycode, true};
+  this->compile_modifier_ = mod;
+  this->compile_key_ = keycode;
+  return n;
+}
+
+// Release whatever the last character left held, then restore Num Lock
+uint8_t HIDComposite::end_text_(QueuedReport *out) {
+  uint8_t n = 0;
+  if (this->compile_modifier_ != 0 || this->compile_key_ != KEY_NONE) out[n++] = {0, KEY_NONE, false};
+  this->start_text_();
+  return n + this->release_num_lock_(out + n);
+}
+
+// Keypad entry needs Num Lock on; it is switched on once per text and switched
+// back off when the text is done.
+uint8_t HIDComposite::release_num_lock_(QueuedReport *out) {
+  if (!this->num_lock_forced_) return 0;
+  this->num_lock_forced_ = false;
+  out[0] = {0, KEY_NUM_LOCK, false};
+  out[1] = {0, KEY_NONE, false};
+  return 2;
+}
+
+// Burst mode (key rollover): consecutive characters that share a modifier and
+// have distinct keycodes are packed into one report, so a group of n characters
+// costs one press and one release report and a single inter-key delay instead of
+// n of each. The host reads the key slots of a report in order, which is text
+// order; the NKRO bitmap is read in usage order, so there a group also ends at a
+// key that comes before the previous one in usage order.
+void HIDComposite::type_burst_(const std::string &text, uint32_t speed_ms, uint32_t jitter_ms, UnicodeMode unicode) {
+  uint8_t keys[KEYBOARD_ROLLOVER];
+  uint8_t count = 0;
+  uint8_t group_mod = 0;
+  QueuedReport reports[MAX_REPORTS_PER_CODEPOINT];
+  Utf8Decoder decoder;
+  size_t skipped = 0;
+  uint32_t first_skipped = 0;
   for (char c : text) {
+    uint32_t codepoint;
+    if (!decoder.feed(c, codepoint)) continue;
     uint8_t keycode, mod;
-    this->char_to_keycode(c, keycode, mod);
-    this->send_keyboard_report(mod, keycode);
+    this->layout_keycode_(codepoint, keycode, mod);
+    if (keycode == KEY_NONE) {
+      uint8_t n = this->unicode_reports_(codepoint, unicode, reports);
+      if (n == 0) {
+        if (skipped++ == 0) first_skipped = codepoint;
+        continue;
+      }
+      uint8_t first_key = KEY_NONE;
+      for (uint8_t i = 0; i < n && first_key == KEY_NONE; i++) first_key = reports[i].keycode;
+      // The group is released before the entry sequence, which starts from an empty report
+      if (count > 0) this->send_burst_group_(group_mod, keys, count, speed_ms, jitter_ms, first_key);
+      count = 0;
+      this->send_reports_(reports, n, speed_ms, jitter_ms);
+      continue;
+    }
+
+    bool fits = count < sizeof(keys) && mod == group_mod;
+    for (uint8_t i = 0; i < count; i++) {
+      if (keys[i] == keycode) fits = false;
+    }
+#ifdef USE_HID_COMPOSITE_NKRO
+    if (count > 0 && keycode < keys[count - 1]) fits = false;
+#endif
+    if (count > 0 && !fits) {
+      this->send_burst_group_(group_mod, keys, count, speed_ms, jitter_ms, keycode);
+      count = 0;
+    }
+    group_mod = mod;
+    keys[count++] = keycode;
+  }
+  if (count > 0) this->send_burst_group_(group_mod, keys, count, speed_ms, jitter_ms, KEY_NONE);
+  uint8_t n = this->release_num_lock_(reports);
+  this->send_reports_(reports, n, speed_ms, jitter_ms);
+  this->report_skipped_(skipped, first_skipped, unicode);
+}
+
+// One burst group: the modifier goes down a report before the keys, as in
+// compile_codepoint_, and the keys are held for a single report interval, far
+// below KEY_HOLD_MAX_MS, so the host never starts autorepeat. The delay to the
+// next group is one digraph gap, from the group's last key to the next key.
+void HIDComposite::send_burst_group_(uint8_t modifier, const uint8_t *keys, uint8_t count, uint32_t speed_ms,
+                                     uint32_t jitter_ms, uint8_t next_key) {
+  if (modifier != 0) {
+    this->send_keyboard_report(modifier, KEY_NONE);
     delay(10);
-    this->send_keyboard_report(0, 0);
-    
-    // Calculate delay with jitter
-    uint32_t delay_ms = speed_ms;
-    if (jitter_ms > 0) {
-      int32_t jitter = (rand() % (jitter_ms * 2 + 1)) - jitter_ms;
-      delay_ms = (int32_t)speed_ms + jitter > 10 ? speed_ms + jitter : 10;
+  }
+  this->send_keyboard_report(modifier, keys, count);
+  delay(10);
+  this->send_keyboard_report(0, nullptr, 0);
+  delay(this->type_delay_(speed_ms, jitter_ms, keys[count - 1], next_key));
+}
+
+// Unicode entry for characters the layout cannot produce, through the host's
+// input method. The entry modifier stays held across the whole sequence and each
+// digit replaces the previous one in the same report slot, so a codepoint costs
+// one report per keystroke (plus an empty slot between two equal digits) and a
+// single release, which also commits the character on every supported host.
+uint8_t HIDComposite::unicode_reports_(uint32_t codepoint, UnicodeMode mode, QueuedReport *out) {
+  if (mode == UNICODE_NONE) return 0;
+  uint8_t modifier;
+  uint8_t seq[12];
+  uint8_t n = 0;
+  char digits[12];
+  bool keypad = false;
+  switch (mode) {
+    case UNICODE_LINUX:
+      // Ctrl+Shift+U, hex digits, commit on Ctrl+Shift release (GTK / IBus)
+      modifier = MOD_LEFT_CTRL | MOD_LEFT_SHIFT;
+      seq[n++] = KEY_U;  // same position on all supported layouts
+      snprintf(digits, sizeof(digits), "%" PRIx32, codepoint);
+      break;
+    case UNICODE_WINDOWS_ALT:
+      // Alt + 0 + decimal on the keypad. The leading 0 selects the ANSI code page
+      // (cp1252), which only matches Unicode for U+00A0..U+00FF: 0x80-0x9F are
+      // other characters there, and codes without the 0 go through the OEM code
+      // page modulo 256. Anything else is skipped.
+      if (codepoint < 0xA0 || codepoint > 0xFF) return 0;
+      modifier = MOD_LEFT_ALT;
+      keypad = true;
+      snprintf(digits, sizeof(digits), "0%" PRIu32, codepoint);
+      break;
+    case UNICODE_WINDOWS_HEX:
+      // Alt + keypad '+' + hex digits (requires EnableHexNumpad in the registry)
+      modifier = MOD_LEFT_ALT;
+      keypad = true;
+      seq[n++] = KEY_KP_PLUS;
+      snprintf(digits, sizeof(digits), "%" PRIx32, codepoint);
+      break;
+    case UNICODE_MACOS:
+      // Option + 4 hex digits per UTF-16 unit ("Unicode Hex Input" source)
+      modifier = MOD_LEFT_ALT;
+      if (codepoint > 0xFFFF) {
+        uint32_t offset = codepoint - 0x10000;
+        snprintf(digits, sizeof(digits), "%04" PRIx32 "%04" PRIx32, 0xD800 + (offset >> 10),
+                 0xDC00 + (offset & 0x3FF));
+      } else {
+        snprintf(digits, sizeof(digits), "%04" PRIx32, codepoint);
+      }
+      break;
+    default:
+      return 0;
+  }
+  for (const char *d = digits; *d != '\0' && n < sizeof(seq); d++) {
+    uint8_t nibble = *d <= '9' ? *d - '0' : *d - 'a' + 10;
+    seq[n++] = this->hex_digit_keycode_(nibble, keypad);
+  }
+
+  uint8_t count = 0;
+  if (keypad && !this->num_lock_forced_ && this->keyboard_leds_received_ && !(this->keyboard_leds_ & LED_NUM_LOCK)) {
+    ESP_LOGD(TAG, "Enabling Num Lock for keypad entry");
+    out[count++] = {0, KEY_NUM_LOCK, false};
+    out[count++] = {0, KEY_NONE, false};
+    this->num_lock_forced_ = true;
+  }
+  for (uint8_t i = 0; i < n; i++) {
+    if (i > 0 && seq[i] == seq[i - 1]) out[count++] = {modifier, KEY_NONE, false};
+    out[count++] = {modifier, seq[i], false};
+  }
+  out[count++] = {0, KEY_NONE, true};
+  ESP_LOGV(TAG, "Unicode U+%04" PRIX32 ": %d reports", codepoint, count);
+  return count;
+}
+
+// ============ Streaming typing engine ============
+//
+// Text is pulled from a TypeSource a small chunk at a time, translated into
+// reports only when the queue has room for a whole code point, and loop() sends
+// one report whenever it is due. Memory use does not depend on the text length
+// and nothing blocks the main loop.
+
+// Reads a file through the VFS in small unbuffered chunks
+class FileTypeSource : public TypeSource {
+ public:
+  explicit FileTypeSource(FILE *file) : file_(file) { setvbuf(file, nullptr, _IONBF, 0); }
+  ~FileTypeSource() override { fclose(this->file_); }
+  size_t read(char *buffer, size_t len) override {
+    size_t n = fread(buffer, 1, len, this->file_);
+    if (n == 0) this->finished_ = true;
+    return n;
+  }
+  bool finished() override { return this->finished_; }
+
+ protected:
+  FILE *file_;
+  bool finished_{false};
+};
+
+void HIDComposite::type_file(const std::string &path, uint32_t speed_ms, uint32_t jitter_ms, UnicodeMode unicode,
+                             std::function<void()> &&on_done) {
+  FILE *file = fopen(path.c_str(), "r");
+  if (file == nullptr) {
+    ESP_LOGE(TAG, "Cannot open %s", path.c_str());
+    if (on_done) on_done();
+    return;
+  }
+  ESP_LOGI(TAG, "Type file: %s (speed=%dms, jitter=%dms)", path.c_str(), speed_ms, jitter_ms);
+  this->start_typing_(std::make_unique<FileTypeSource>(file), speed_ms, jitter_ms, unicode, std::move(on_done));
+}
+
+size_t TextRingBuffer::write(const char *data, size_t len) {
+  size_t capacity = this->data_.size();
+  if (len > capacity - this->count_) len = capacity - this->count_;
+  size_t tail = (this->head_ + this->count_) % capacity;
+  for (size_t i = 0; i < len; i++) {
+    this->data_[tail] = data[i];
+    tail = tail + 1 == capacity ? 0 : tail + 1;
+  }
+  this->count_ += len;
+  return len;
+}
+
+size_t TextRingBuffer::read(char *buffer, size_t len) {
+  size_t capacity = this->data_.size();
+  if (len > this->count_) len = this->count_;
+  for (size_t i = 0; i < len; i++) {
+    buffer[i] = this->data_[this->head_];
+    this->head_ = this->head_ + 1 == capacity ? 0 : this->head_ + 1;
+  }
+  this->count_ -= len;
+  return len;
+}
+
+#ifdef USE_HID_COMPOSITE_TEXT_STREAM
+// Drains the API ring buffer; the text ends once the final chunk is consumed
+class StreamTypeSource : public TypeSource {
+ public:
+  StreamTypeSource(TextRingBuffer *buffer, const bool *final) : buffer_(buffer), final_(final) {}
+  size_t read(char *buffer, size_t len) override { return this->buffer_->read(buffer, len); }
+  bool finished() override { return *this->final_ && this->buffer_->available() == 0; }
+
+ protected:
+  TextRingBuffer *buffer_;
+  const bool *final_;
+};
+
+// Chunks are numbered from 0 for each text. Every call is answered with an
+// esphome.hid_composite_text_stream event carrying the status and the free
+// buffer space, so the sender can pace itself:
+//   ok           chunk accepted
+//   full         chunk larger than the free space; resend it after "ready"
+//   too_large    chunk larger than the whole buffer; split it
+//   out_of_order seq is not the expected one (see "seq" in the reply)
+//   busy         another text is being typed
+//   ready        space was freed after a "full" reply
+//   done         the final chunk has been typed
+// Typing starts with chunk 0, so the host types while later chunks arrive.
+void HIDComposite::on_text_chunk_(int32_t seq, std::string text, bool final) {
+  // stop_typing() ends the stream without the done callback
+  if (this->stream_active_ && !this->is_typing()) this->stream_active_ = false;
+  if (text.size() > this->stream_buffer_.capacity()) {
+    this->send_stream_status_(seq, "too_large");
+    return;
+  }
+  if (seq == 0) {
+    if (this->stream_active_) {
+      // A new text replaces an unfinished one
+      this->stop_typing();
+      this->stream_active_ = false;
+    }
+    if (this->is_typing()) {
+      this->send_stream_status_(seq, "busy");
+      return;
+    }
+    this->stream_buffer_.clear();
+    this->stream_next_seq_ = 0;
+    this->stream_final_ = false;
+    this->stream_blocked_ = false;
+    this->stream_active_ = true;
+    this->start_typing_(std::make_unique<StreamTypeSource>(&this->stream_buffer_, &this->stream_final_),
+                        this->stream_speed_ms_, this->stream_jitter_ms_, this->stream_unicode_, [this]() {
+                          this->stream_active_ = false;
+                          this->send_stream_status_(this->stream_next_seq_ - 1, "done");
+                        });
+    ESP_LOGI(TAG, "Text stream started");
+  } else if (!this->stream_active_ || this->stream_final_ || seq != this->stream_next_seq_) {
+    ESP_LOGW(TAG, "Text chunk %" PRId32 " out of order (expected %" PRId32 ")", seq, this->stream_next_seq_);
+    this->send_stream_status_(this->stream_next_seq_, "out_of_order");
+    return;
+  }
+  if (text.size() > this->stream_buffer_.free()) {
+    this->stream_blocked_ = true;
+    this->send_stream_status_(seq, "full");
+    return;
+  }
+  this->stream_buffer_.write(text.data(), text.size());
+  this->stream_next_seq_ = seq + 1;
+  this->stream_final_ = final;
+  ESP_LOGD(TAG, "Text chunk %" PRId32 ": %u bytes, %u free", seq, (unsigned) text.size(),
+           (unsigned) this->stream_buffer_.free());
+  this->send_stream_status_(seq, "ok");
+}
+
+void HIDComposite::send_stream_status_(int32_t seq, const char *status) {
+  this->fire_homeassistant_event("esphome.hid_composite_text_stream",
+                                 {
+                                     {"seq", std::to_string(seq)},
+                                     {"status", status},
+                                     {"free", std::to_string(this->stream_buffer_.free())},
+                                 });
+}
+#endif
+
+// Decompresses an LZSS text from flash through a small window (see lzss.py)
+class LzssTypeSource : public TypeSource {
+ public:
+  LzssTypeSource(const uint8_t *data, size_t len) : data_(data), end_(data + len) {}
+  size_t read(char *buffer, size_t len) override {
+    size_t n = 0;
+    while (n < len) {
+      if (this->match_left_ > 0) {
+        buffer[n++] = this->put_(this->window_[(this->window_pos_ - this->match_distance_) & WINDOW_MASK]);
+        this->match_left_--;
+        continue;
+      }
+      if (this->data_ == this->end_) break;
+      if (this->flag_bits_ == 0) {
+        this->flags_ = *this->data_++;
+        this->flag_bits_ = 8;
+        continue;
+      }
+      bool literal = this->flags_ & 1;
+      this->flags_ >>= 1;
+      this->flag_bits_--;
+      if (literal) {
+        buffer[n++] = this->put_(*this->data_++);
+      } else if (this->end_ - this->data_ >= 2) {
+        uint16_t token = (this->data_[0] << 8) | this->data_[1];
+        this->data_ += 2;
+        this->match_distance_ = (token >> LZSS_LENGTH_BITS) + 1;
+        this->match_left_ = (token & ((1 << LZSS_LENGTH_BITS) - 1)) + LZSS_MIN_MATCH;
+      } else {
+        this->data_ = this->end_;  // truncated token
+      }
+    }
+    return n;
+  }
+  bool finished() override { return this->data_ == this->end_ && this->match_left_ == 0; }
+
+ protected:
+  static const uint16_t WINDOW_MASK = (1 << LZSS_WINDOW_BITS) - 1;
+  char put_(char c) {
+    this->window_[this->window_pos_++ & WINDOW_MASK] = c;
+    return c;
+  }
+
+  const uint8_t *data_;
+  const uint8_t *end_;
+  uint8_t flags_{0};
+  uint8_t flag_bits_{0};
+  uint16_t match_distance_{0};
+  uint8_t match_left_{0};
+  uint16_t window_pos_{0};
+  char window_[1 << LZSS_WINDOW_BITS];
+};
+
+void HIDComposite::type_compressed(const uint8_t *data, size_t len, uint32_t speed_ms, uint32_t jitter_ms,
+                                   UnicodeMode unicode, std::function<void()> &&on_done) {
+  ESP_LOGI(TAG, "Type compressed text: %u bytes (speed=%dms, jitter=%dms)", (unsigned) len, speed_ms, jitter_ms);
+  this->start_typing_(std::make_unique<LzssTypeSource>(data, len), speed_ms, jitter_ms, unicode, std::move(on_done));
+}
+
+bool HIDComposite::start_typing_(std::unique_ptr<TypeSource> source, uint32_t speed_ms, uint32_t jitter_ms,
+                                 UnicodeMode unicode, std::function<void()> &&on_done) {
+  if (this->type_source_ != nullptr) {
+    ESP_LOGW(TAG, "Already typing, request ignored");
+    if (on_done) on_done();
+    return false;
+  }
+  this->type_source_ = std::move(source);
+  this->type_done_ = std::move(on_done);
+  this->type_speed_ms_ = speed_ms;
+  this->type_jitter_ms_ = jitter_ms;
+  this->type_unicode_mode_ = unicode;
+  this->type_queue_head_ = 0;
+  this->type_queue_count_ = 0;
+  this->type_chunk_pos_ = 0;
+  this->type_chunk_len_ = 0;
+  this->type_decoder_ = Utf8Decoder();
+  this->type_source_done_ = false;
+  this->type_next_report_ = millis();
+  this->type_last_key_ = KEY_NONE;
+  this->type_slot_release_pending_ = false;
+  this->start_text_();
+  this->type_skipped_ = 0;
+  this->type_high_freq_.start();
+  return true;
+}
+
+void HIDComposite::stop_typing() {
+  if (this->type_source_ == nullptr) return;
+  ESP_LOGI(TAG, "Typing stopped");
+  this->type_done_ = nullptr;
+  this->finish_typing_();
+}
+
+void HIDComposite::finish_typing_() {
+  this->report_skipped_(this->type_skipped_, this->type_first_skipped_, this->type_unicode_mode_);
+  this->type_source_.reset();
+  this->type_queue_count_ = 0;
+  this->type_high_freq_.stop();
+  if (this->num_lock_forced_) {
+    QueuedReport reports[2];
+    uint8_t n = this->release_num_lock_(reports);
+    this->send_reports_(reports, n, 0, 0);
+  }
+  // Keys still held by key_press stay down once the text is typed
+  this->send_held_keys_();
+  auto on_done = std::move(this->type_done_);
+  this->type_done_ = nullptr;
+  if (on_done) on_done();
+}
+
+void HIDComposite::push_reports_(const QueuedReport *reports, uint8_t count) {
+  for (uint8_t i = 0; i < count; i++) {
+    uint8_t tail = (this->type_queue_head_ + this->type_queue_count_) % TYPE_QUEUE_SIZE;
+    this->type_queue_[tail] = reports[i];
+    this->type_queue_count_++;
+  }
+}
+
+void HIDComposite::fill_type_queue_() {
+  QueuedReport reports[MAX_REPORTS_PER_CODEPOINT];
+  while (!this->type_source_done_ && TYPE_QUEUE_SIZE - this->type_queue_count_ >= MAX_REPORTS_PER_CODEPOINT) {
+    if (this->type_chunk_pos_ == this->type_chunk_len_) {
+      this->type_chunk_len_ = this->type_source_->read(this->type_chunk_, sizeof(this->type_chunk_));
+      this->type_chunk_pos_ = 0;
+      if (this->type_chunk_len_ > 0) continue;
+      if (this->type_source_->finished()) {
+        this->type_source_done_ = true;
+        this->push_reports_(reports, this->end_text_(reports));
+      }
+      return;
+    }
+    uint32_t codepoint;
+    if (!this->type_decoder_.feed(this->type_chunk_[this->type_chunk_pos_++], codepoint)) continue;
+    uint8_t n = this->compile_codepoint_(codepoint, this->type_unicode_mode_, reports);
+    if (n == 0 && this->type_skipped_++ == 0) this->type_first_skipped_ = codepoint;
+    this->push_reports_(reports, n);
+  }
+}
+
+void HIDComposite::process_type_queue_() {
+  if (this->type_source_ == nullptr) return;
+  uint32_t now = millis();
+  if (this->type_slot_release_pending_ && (int32_t) (now - this->type_slot_release_at_) >= 0 && tud_hid_ready()) {
+    this->send_keyboard_report(this->type_slot_release_modifier_, KEY_NONE);
+    this->type_slot_release_pending_ = false;
+  }
+  if ((int32_t) (now - this->type_next_report_) < 0) return;
+  if (!this->is_connected()) {
+    ESP_LOGW(TAG, "Host disconnected, typing aborted");
+    this->finish_typing_();
+    return;
+  }
+  this->fill_type_queue_();
+  if (this->type_queue_count_ == 0) {
+    if (this->type_source_done_) this->finish_typing_();
+    return;
+  }
+  // The endpoint is still busy with the previous report: retry on the next loop
+  if (!tud_hid_ready()) return;
+  const QueuedReport &report = this->type_queue_[this->type_queue_head_];
+  this->send_keyboard_report(report.modifier, report.keycode);
+  if (report.keycode != KEY_NONE) this->type_last_key_ = report.keycode;
+  uint32_t gap = 10;
+  if (report.end_of_char) {
+    uint8_t next_key = KEY_NONE;
+    for (uint8_t i = 1; i < this->type_queue_count_ && next_key == KEY_NONE; i++) {
+      next_key = this->type_queue_[(this->type_queue_head_ + i) % TYPE_QUEUE_SIZE].keycode;
     }
-    delay(delay_ms);
+    gap = this->type_delay_(this->type_speed_ms_, this->type_jitter_ms_, this->type_last_key_, next_key);
+    if (report.keycode != KEY_NONE && gap > KEY_HOLD_MAX_MS) {
+      this->type_slot_release_pending_ = true;
+      this->type_slot_release_modifier_ = report.modifier;
+      this->type_slot_release_at_ = now + 10;
+    }
+  }
+  this->type_next_report_ = now + gap;
+  this->type_queue_head_ = (this->type_queue_head_ + 1) % TYPE_QUEUE_SIZE;
+  this->type_queue_count_--;
+}
+
+uint8_t HIDComposite::hex_digit_keycode_(uint8_t nibble, bool keypad) {
+  if (nibble >= 10) {
+    // Letters move between layouts (AZERTY 'a' is the Q key)
+    uint8_t keycode, modifier;
+    this->char_to_keycode('a' + nibble - 10, keycode, modifier);
+    return keycode;
   }
+  if (nibble == 0) return keypad ? KEY_KP_0 : KEY_0;
+  return (keypad ? KEY_KP_1 : KEY_1) + nibble - 1;
+}
+
+uint32_t HIDComposite::type_delay_(uint32_t speed_ms, uint32_t jitter_ms, uint8_t from, uint8_t to) {
+  return this->typing_model_.delay(this->rng_, speed_ms, jitter_ms, from, to);
 }
 
+#if defined(HID_COMPOSITE_RUNTIME_LAYOUT) || defined(USE_HID_COMPOSITE_LAYOUT_QWERTY_US)
 // QWERTY US layout mapping
 void HIDComposite::char_to_keycode_qwerty(char c, uint8_t &keycode, uint8_t &modifier) {
   modifier = 0;
@@ -496,7 +2221,9 @@ void HIDComposite::char_to_keycode_qwerty(char c, uint8_t &keycode, uint8_t &mod
     default: keycode = KEY_NONE; break;
   }
 }
+#endif
 
+#if defined(HID_COMPOSITE_RUNTIME_LAYOUT) || defined(USE_HID_COMPOSITE_LAYOUT_AZERTY_FR)
 // AZERTY FR layout mapping
 void HIDComposite::char_to_keycode_azerty(char c, uint8_t &keycode, uint8_t &modifier) {
   modifier = 0;
@@ -543,7 +2270,9 @@ void HIDComposite::char_to_keycode_azerty(char c, uint8_t &keycode, uint8_t &mod
     default: keycode = KEY_NONE; break;
   }
 }
+#endif
 
+#if defined(HID_COMPOSITE_RUNTIME_LAYOUT) || defined(USE_HID_COMPOSITE_LAYOUT_QWERTZ_DE)
 // QWERTZ DE layout mapping
 void HIDComposite::char_to_keycode_qwertz(char c, uint8_t &keycode, uint8_t &modifier) {
   modifier = 0;
@@ -580,9 +2309,17 @@ void HIDComposite::char_to_keycode_qwertz(char c, uint8_t &keycode, uint8_t &mod
     default: keycode = KEY_NONE; break;
   }
 }
+#endif
 
 // Main dispatcher based on layout
 void HIDComposite::char_to_keycode(char c, uint8_t &keycode, uint8_t &modifier) {
+#if defined(USE_HID_COMPOSITE_LAYOUT_AZERTY_FR)
+  this->char_to_keycode_azerty(c, keycode, modifier);
+#elif defined(USE_HID_COMPOSITE_LAYOUT_QWERTZ_DE)
+  this->char_to_keycode_qwertz(c, keycode, modifier);
+#elif defined(USE_HID_COMPOSITE_LAYOUT_QWERTY_US)
+  this->char_to_keycode_qwerty(c, keycode, modifier);
+#else
   switch (this->layout_) {
     case LAYOUT_AZERTY_FR:
       this->char_to_keycode_azerty(c, keycode, modifier);
@@ -595,32 +2332,13 @@ void HIDComposite::char_to_keycode(char c, uint8_t &keycode, uint8_t &modifier)
       this->char_to_keycode_qwerty(c, keycode, modifier);
       break;
   }
+#endif
 }
 
 uint8_t HIDComposite::key_name_to_keycode(const std::string &key) {
-  std::string k = key;
-  for (char &c : k) if (c >= 'a' && c <= 'z') c -= 32;
-  if (k == "ENTER" || k == "RETURN") return KEY_ENTER;
-  if (k == "ESC" || k == "ESCAPE") return KEY_ESC;
-  if (k == "BACKSPACE") return KEY_BACKSPACE;
-  if (k == "TAB") return KEY_TAB;
-  if (k == "SPACE") return KEY_SPACE;
-  if (k == "DELETE") return KEY_DELETE;
-  if (k == "INSERT") return KEY_INSERT;
-  if (k == "HOME") return KEY_HOME;
-  if (k == "END") return KEY_END;
-  if (k == "PAGEUP") return KEY_PAGE_UP;
-  if (k == "PAGEDOWN") return KEY_PAGE_DOWN;
-  if (k == "UP") return KEY_UP_ARROW;
-  if (k == "DOWN") return KEY_DOWN_ARROW;
-  if (k == "LEFT") return KEY_LEFT_ARROW;
-  if (k == "RIGHT") return KEY_RIGHT_ARROW;
-  if (k == "F1") return KEY_F1; if (k == "F2") return KEY_F2; if (k == "F3") return KEY_F3;
-  if (k == "F4") return KEY_F4; if (k == "F5") return KEY_F5; if (k == "F6") return KEY_F6;
-  if (k == "F7") return KEY_F7; if (k == "F8") return KEY_F8; if (k == "F9") return KEY_F9;
-  if (k == "F10") return KEY_F10; if (k == "F11") return KEY_F11; if (k == "F12") return KEY_F12;
-  ESP_LOGW(TAG, "Unknown key: %s", key.c_str());
-  return KEY_NONE;
+  uint8_t usage = hid_common::lookup_key_name(key.data(), key.size());
+  if (usage == KEY_NONE) ESP_LOGW(TAG, "Unknown key: %s", key.c_str());
+  return usage;
 }
 
 void HIDComposite::start_mouse_keep_awake(uint32_t interval_ms, uint32_t jitter_ms) {
@@ -639,7 +2357,7 @@ void HIDComposite::stop_mouse_keep_awake() {
 
 void HIDComposite::start_keyboard_keep_awake(const std::string &key, uint32_t interval_ms, uint32_t jitter_ms) {
   ESP_LOGI(TAG, "Starting keyboard keep awake: key=%s, interval=%dms, jitter=%dms", key.c_str(), interval_ms, jitter_ms);
-  this->keyboard_keep_awake_key_ = key;
+  this->keyboard_keep_awake_usage_ = this->resolve_key_(key, this->keyboard_keep_awake_modifier_);
   this->keyboard_keep_awake_interval_ = interval_ms;
   this->keyboard_keep_awake_jitter_ = jitter_ms;
   this->keyboard_keep_awake_last_time_ = millis();
@@ -834,8 +2552,10 @@ void HIDComposite::process_host_report(uint8_t report_id, uint8_t const *buffer,
       this->ring_callbacks_.call(new_ringing);
     }
   } else if (report_id == REPORT_ID_KEYBOARD) {
-    // Keyboard LED report (Num Lock, Caps Lock, etc)
+    // Keyboard LED report: bit 0 = Num Lock, bit 1 = Caps Lock, bit 2 = Scroll Lock
     ESP_LOGD(TAG, "Keyboard LED report: 0x%02X", buffer[0]);
+    this->keyboard_leds_ = buffer[0];
+    this->keyboard_leds_received_ = true;
   } else {
     ESP_LOGD(TAG, "Unknown report ID: 0x%02X", report_id);
   }
@@ -852,24 +2572,134 @@ static const char *const TAG = "hid_composite";
 void HIDComposite::setup() { ESP_LOGE(TAG, "Only supported on ESP32-S3/S2"); }
 void HIDComposite::loop() {}
 void HIDComposite::dump_config() {}
-void HIDComposite::move(int8_t x, int8_t y) {}
-void HIDComposite::scroll(int8_t vertical, int8_t horizontal) {}
-void HIDComposite::click(MouseButton button) {}
+void HIDComposite::move(int16_t x, int16_t y) {}
+void HIDComposite::scroll(float vertical, float horizontal) {}
+void HIDComposite::flush_scroll_() {}
+void HIDComposite::kinetic_scroll(float vertical, float horizontal, float friction) {}
+void HIDComposite::stop_kinetic_scroll() {}
+void HIDComposite::process_kinetic_() {}
+uint16_t HIDComposite::get_feature_report(uint8_t report_id, uint8_t *buffer, uint16_t reqlen) { return 0; }
+void HIDComposite::process_feature_report(uint8_t report_id, uint8_t const *buffer, uint16_t bufsize) {}
+void HIDComposite::apply_scroll_feature_() {}
+void HIDComposite::click(MouseButton button, std::function<void()> &&on_done) {
+  if (on_done) on_done();
+}
+void HIDComposite::double_click(MouseButton button, uint32_t interval_ms, std::function<void()> &&on_done) {
+  if (on_done) on_done();
+}
+void HIDComposite::drag(MouseButton button, int32_t x, int32_t y, uint32_t duration_ms,
+                        std::function<void()> &&on_done) {
+  if (on_done) on_done();
+}
+void HIDComposite::stop_gestures() {}
+void HIDComposite::queue_gesture_(std::initializer_list<GestureStep> steps, std::function<void()> &&on_done) {}
+void HIDComposite::process_gesture_() {}
+void HIDComposite::finish_gestures_(bool notify) {}
 void HIDComposite::mouse_press(MouseButton button) {}
 void HIDComposite::mouse_release(MouseButton button) {}
 void HIDComposite::mouse_release_all() {}
+bool HIDComposite::send_mouse_(int16_t x, int16_t y, int16_t wheel, int16_t pan) { return false; }
+bool HIDComposite::send_jiggle_(int16_t x, int16_t y) { return false; }
+bool HIDComposite::send_absolute_(uint16_t x, uint16_t y) { return false; }
+void HIDComposite::move_absolute(uint16_t x, uint16_t y) {}
+void HIDComposite::move_path(int32_t x, int32_t y, uint32_t duration_ms, const Easing &easing,
+                             std::function<void()> &&on_done) {
+  if (on_done) on_done();
+}
+void HIDComposite::stop_move_path() {}
+#ifdef USE_HID_COMPOSITE_BALLISTICS
+void HIDComposite::move_pixels(int32_t x, int32_t y, std::function<void()> &&on_done) {
+  if (on_done) on_done();
+}
+void HIDComposite::stop_move_pixels() {}
+void HIDComposite::add_ballistics_point(float counts, float pixels) {}
+float HIDComposite::ballistics_pixels_(float counts) const { return 0; }
+float HIDComposite::ballistics_counts_(float pixels) const { return 0; }
+void HIDComposite::process_pixels_() {}
+void HIDComposite::finish_pixels_() {}
+#endif
+void HIDComposite::finish_path_() {}
+int32_t HIDComposite::path_progress_(uint32_t t) const { return 0; }
+void HIDComposite::process_path_() {}
+#ifdef USE_HID_COMPOSITE_RECORDING
+void HIDComposite::start_recording(const std::string &name) {}
+void HIDComposite::stop_recording() {}
+void HIDComposite::record_report_(bool absolute, int32_t x, int32_t y, int32_t wheel, int32_t pan) {}
+bool HIDComposite::record_flush_() { return false; }
+void HIDComposite::replay(const std::string &name, std::function<void()> &&on_done) {
+  if (on_done) on_done();
+}
+void HIDComposite::stop_replay() {}
+void HIDComposite::finish_replay_() {}
+bool HIDComposite::replay_decode_() { return false; }
+void HIDComposite::process_replay_() {}
+#endif
 void HIDComposite::key_press(const std::string &key, uint8_t modifier) {}
 void HIDComposite::key_release() {}
+void HIDComposite::key_release(const std::string &key) {}
 void HIDComposite::key_release_all() {}
 void HIDComposite::key_tap(const std::string &key, uint8_t modifier) {}
-void HIDComposite::type(const std::string &text, uint32_t speed_ms, uint32_t jitter_ms) {}
+void HIDComposite::press_usage(uint8_t usage, uint8_t modifier) {}
+void HIDComposite::release_usage(uint8_t usage, uint8_t modifier) {}
+void HIDComposite::tap_usage(uint8_t usage, uint8_t modifier) {}
+void HIDComposite::chord(const std::vector<uint8_t> &usages, uint8_t modifier) {}
+void HIDComposite::chord(const std::vector<std::string> &keys, uint8_t modifier) {}
+void HIDComposite::schedule_tap_release_(uint32_t delay_ms) {}
+void HIDComposite::release_taps_() {}
+uint8_t HIDComposite::resolve_key_(const std::string &key, uint8_t &modifier) { return 0; }
+bool HIDComposite::hold_usage_(uint8_t usage, uint8_t modifier) { return false; }
+void HIDComposite::drop_usage_(uint8_t usage, uint8_t modifier) {}
+void HIDComposite::send_held_keys_() {}
+void HIDComposite::type(const std::string &text, uint32_t speed_ms, uint32_t jitter_ms, bool burst,
+                        UnicodeMode unicode) {}
+void HIDComposite::type_burst_(const std::string &text, uint32_t speed_ms, uint32_t jitter_ms, UnicodeMode unicode) {}
+void HIDComposite::send_burst_group_(uint8_t modifier, const uint8_t *keys, uint8_t count, uint32_t speed_ms,
+                                     uint32_t jitter_ms, uint8_t next_key) {}
+uint8_t HIDComposite::unicode_reports_(uint32_t codepoint, UnicodeMode mode, QueuedReport *out) { return 0; }
+void HIDComposite::start_text_() {}
+uint8_t HIDComposite::compile_codepoint_(uint32_t codepoint, UnicodeMode unicode, QueuedReport *out) { return 0; }
+uint8_t HIDComposite::end_text_(QueuedReport *out) { return 0; }
+uint8_t HIDComposite::release_num_lock_(QueuedReport *out) { return 0; }
+void HIDComposite::compile_text_(const std::string &text, UnicodeMode unicode, std::vector<QueuedReport> &out) {}
+void HIDComposite::report_skipped_(size_t count, uint32_t first, UnicodeMode unicode) {}
+void HIDComposite::send_reports_(const QueuedReport *reports, size_t count, uint32_t speed_ms, uint32_t jitter_ms) {}
+void HIDComposite::type_file(const std::string &path, uint32_t speed_ms, uint32_t jitter_ms, UnicodeMode unicode,
+                             std::function<void()> &&on_done) {
+  if (on_done) on_done();
+}
+void HIDComposite::type_compressed(const uint8_t *data, size_t len, uint32_t speed_ms, uint32_t jitter_ms,
+                                   UnicodeMode unicode, std::function<void()> &&on_done) {
+  if (on_done) on_done();
+}
+bool HIDComposite::start_typing_(std::unique_ptr<TypeSource> source, uint32_t speed_ms, uint32_t jitter_ms,
+                                 UnicodeMode unicode, std::function<void()> &&on_done) {
+  return false;
+}
+void HIDComposite::stop_typing() {}
+void HIDComposite::finish_typing_() {}
+void HIDComposite::push_reports_(const QueuedReport *reports, uint8_t count) {}
+void HIDComposite::fill_type_queue_() {}
+void HIDComposite::process_type_queue_() {}
+bool Utf8Decoder::feed(uint8_t byte, uint32_t &codepoint) { return false; }
+size_t TextRingBuffer::write(const char *data, size_t len) { return 0; }
+size_t TextRingBuffer::read(char *buffer, size_t len) { return 0; }
+#ifdef USE_HID_COMPOSITE_TEXT_STREAM
+void HIDComposite::on_text_chunk_(int32_t seq, std::string text, bool final) {}
+void HIDComposite::send_stream_status_(int32_t seq, const char *status) {}
+#endif
+uint8_t HIDComposite::hex_digit_keycode_(uint8_t nibble, bool keypad) { return 0; }
+uint32_t HIDComposite::type_delay_(uint32_t speed_ms, uint32_t jitter_ms, uint8_t from, uint8_t to) {
+  return speed_ms;
+}
 void HIDComposite::char_to_keycode(char c, uint8_t &keycode, uint8_t &modifier) {}
 void HIDComposite::char_to_keycode_qwerty(char c, uint8_t &keycode, uint8_t &modifier) {}
 void HIDComposite::char_to_keycode_azerty(char c, uint8_t &keycode, uint8_t &modifier) {}
 void HIDComposite::char_to_keycode_qwertz(char c, uint8_t &keycode, uint8_t &modifier) {}
 uint8_t HIDComposite::key_name_to_keycode(const std::string &key) { return 0; }
 void HIDComposite::send_mouse_report() {}
+bool HIDComposite::send_buttons_() { return false; }
 void HIDComposite::send_keyboard_report(uint8_t modifier, uint8_t keycode) {}
+void HIDComposite::send_keyboard_report(uint8_t modifier, const uint8_t *keycodes, uint8_t count) {}
 void HIDComposite::start_mouse_keep_awake(uint32_t interval_ms, uint32_t jitter_ms) {}
 void HIDComposite::stop_mouse_keep_awake() {}
 void HIDComposite::start_keyboard_keep_awake(const std::string &key, uint32_t interval_ms, uint32_t jitter_ms) {}
@@ -888,7 +2718,8 @@ void HIDComposite::hook_switch(bool state) {}
 void HIDComposite::answer_call() {}
 void HIDComposite::hang_up() {}
 void HIDComposite::send_telephony_report() {}
-void HIDComposite::process_host_report(uint8_t const *buffer, uint16_t bufsize) {}
+void HIDComposite::process_host_report(uint8_t report_id, uint8_t const *buffer, uint16_t bufsize) {}
+void HIDComposite::layout_keycode_(uint32_t codepoint, uint8_t &keycode, uint8_t &modifier) {}
 }  // namespace hid_composite
 }  // namespace esphome
 
@@ -1,8 +1,24 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/defines.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/automation.h"
+#include "esphome/components/hid_common/typing_model.h"
+#include "esphome/components/hid_common/xoshiro.h"
+
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#ifdef USE_HID_COMPOSITE_TEXT_STREAM
+#include "esphome/components/api/custom_api_device.h"
+#endif
+#ifdef USE_HID_COMPOSITE_RECORDING
+#include "esphome/core/preferences.h"
+#endif
 
 #ifdef USE_ESP32
 #include <soc/soc_caps.h>
@@ -11,6 +27,13 @@
 #endif
 #endif
 
+// The configured layout is compiled in alone; all layouts and the per-character
+// switch are kept only with runtime_layout: true
+#if !defined(USE_HID_COMPOSITE_LAYOUT_QWERTY_US) && !defined(USE_HID_COMPOSITE_LAYOUT_AZERTY_FR) && \
+    !defined(USE_HID_COMPOSITE_LAYOUT_QWERTZ_DE)
+#define HID_COMPOSITE_RUNTIME_LAYOUT
+#endif
+
 namespace esphome {
 namespace hid_composite {
 
@@ -21,6 +44,22 @@ enum KeyboardLayout : uint8_t {
   LAYOUT_QWERTZ_DE = 2,
 };
 
+// Keyboard LED bits in the host output report
+enum KeyboardLed : uint8_t {
+  LED_NUM_LOCK = 0x01,
+  LED_CAPS_LOCK = 0x02,
+  LED_SCROLL_LOCK = 0x04,
+};
+
+// Host input method used by type() for characters the layout cannot produce
+enum UnicodeMode : uint8_t {
+  UNICODE_NONE = 0,
+  UNICODE_LINUX = 1,        // Ctrl+Shift+U + hex
+  UNICODE_WINDOWS_ALT = 2,  // Alt + keypad decimal
+  UNICODE_WINDOWS_HEX = 3,  // Alt + keypad '+' + hex
+  UNICODE_MACOS = 4,        // Option + hex (Unicode Hex Input)
+};
+
 enum MouseButton : uint8_t {
   BUTTON_LEFT = 0,
   BUTTON_RIGHT = 1,
@@ -39,26 +78,246 @@ enum Modifier : uint8_t {
   MOD_RIGHT_GUI = 0x80,
 };
 
-class HIDComposite : public Component {
+// Non-modifier keys that can be held at once (pressed-key set, burst typing groups)
+#ifdef USE_HID_COMPOSITE_NKRO
+static const uint8_t KEYBOARD_ROLLOVER = 16;
+#else
+static const uint8_t KEYBOARD_ROLLOVER = 6;
+#endif
+
+// Streaming typing engine buffers
+static const uint8_t TYPE_QUEUE_SIZE = 64;            // queued reports
+static const uint8_t TYPE_CHUNK_SIZE = 64;            // bytes read from the source at a time
+static const uint8_t MAX_REPORTS_PER_CODEPOINT = 24;  // worst case: Unicode entry with Num Lock toggle
+// LZSS format of literal texts compressed by the codegen (see lzss.py)
+static const uint8_t LZSS_WINDOW_BITS = 9;  // 512-byte window
+static const uint8_t LZSS_LENGTH_BITS = 7;
+static const uint8_t LZSS_MIN_MATCH = 3;
+
+// A typed key stays down until the next character; past this the key slot is
+// released early so the host does not start autorepeat
+static const uint32_t KEY_HOLD_MAX_MS = 200;
+
+// One keyboard report of a text being typed; end_of_char selects the
+// inter-character delay instead of the 10 ms report gap
+struct QueuedReport {
+  uint8_t modifier;
+  uint8_t keycode;
+  bool end_of_char;
+};
+
+// Text for the streaming typing engine
+class TypeSource {
+ public:
+  virtual ~TypeSource() = default;
+  // Copy up to len bytes into buffer. Returning 0 while finished() is false
+  // means no data is available yet.
+  virtual size_t read(char *buffer, size_t len) = 0;
+  virtual bool finished() = 0;
+};
+
+// Timing curve of a pointer path: cubic Bézier from (0,0) to (1,1) with
+// control points (x1,y1) and (x2,y2), as in CSS cubic-bezier()
+struct Easing {
+  float x1, y1, x2, y2;
+};
+static const uint8_t PATH_CURVE_STEPS = 32;
+// Largest relative motion in one mouse report (X/Y, wheel and pan)
+#ifdef USE_HID_COMPOSITE_WIDE_MOUSE
+static const int16_t MOUSE_DELTA_MAX = 32767;
+#else
+static const int16_t MOUSE_DELTA_MAX = 127;
+#endif
+// Wheel units per detent when the host enables the resolution multiplier
+static const uint8_t SCROLL_RESOLUTION = 120;
+// Integration step of kinetic scrolling, one USB poll interval
+static const uint8_t KINETIC_FRAME_MS = 10;
+// Logical range of the absolute pointer, mapped by the host onto the whole screen
+static const uint16_t ABSOLUTE_MAX = 32767;
+
+// Mouse gestures (click, double_click, drag) run as queued steps from loop().
+// A step changes buttons, then either moves along a path or holds for its
+// duration before the next step starts.
+struct GestureStep {
+  uint8_t press;
+  uint8_t release;
+  int32_t x;
+  int32_t y;
+  uint32_t duration_ms;
+  std::function<void()> on_done;  // set on the last step of a gesture
+};
+static const uint8_t GESTURE_QUEUE_SIZE = 16;
+
+// Host pointer ballistics: pixels the pointer travels for one report, as a
+// function of the report's speed magnitude in counts (max(|x|,|y|) + min/2,
+// as Windows measures it). Piecewise linear, extrapolated past the last point.
+struct BallisticsPoint {
+  float counts;
+  float pixels;
+};
+static const uint8_t BALLISTICS_MAX_POINTS = 16;
+// How long a click holds the button
+static const uint32_t CLICK_HOLD_MS = 10;
+// Pause after the press and before the release of a drag, so hosts register the drag
+static const uint32_t DRAG_HOLD_MS = 50;
+
+class Utf8Decoder {
+ public:
+  // Returns true when byte completes a code point
+  bool feed(uint8_t byte, uint32_t &codepoint);
+
+ protected:
+  uint32_t codepoint_{0};
+  uint8_t pending_{0};
+};
+
+// Fixed-size byte ring for text that arrives in pieces
+class TextRingBuffer {
+ public:
+  void init(size_t capacity) { this->data_.resize(capacity); }
+  // Both return the number of bytes actually copied
+  size_t write(const char *data, size_t len);
+  size_t read(char *buffer, size_t len);
+  size_t available() const { return this->count_; }
+  size_t free() const { return this->data_.size() - this->count_; }
+  size_t capacity() const { return this->data_.size(); }
+  void clear() {
+    this->head_ = 0;
+    this->count_ = 0;
+  }
+
+ protected:
+  std::vector<char> data_;
+  size_t head_{0};
+  size_t count_{0};
+};
+
+#ifdef USE_HID_COMPOSITE_RECORDING
+// A recorded pointer workflow as stored in flash, one preference per name.
+// Each mouse report is a flags byte followed by the fields it needs:
+//   RECORD_BUTTONS   buttons byte, when they changed
+//   RECORD_MOVE      zigzag varints dx, dy (else no motion)
+//   RECORD_SCROLL    zigzag varints wheel, pan (else no scroll)
+//   RECORD_ABSOLUTE  varints x, y of the absolute pointer, instead of a move
+//   RECORD_TIME      varint ms since the previous report, when it changed
+//   RECORD_REPEAT    varint count of identical reports that follow
+struct MouseRecording {
+  uint16_t length;
+  uint8_t data[HID_COMPOSITE_RECORDING_SIZE];
+};
+enum RecordFlag : uint8_t {
+  RECORD_BUTTONS = 0x01,
+  RECORD_MOVE = 0x02,
+  RECORD_SCROLL = 0x04,
+  RECORD_ABSOLUTE = 0x08,
+  RECORD_TIME = 0x10,
+  RECORD_REPEAT = 0x20,
+};
+struct RecordedReport {
+  bool absolute;
+  uint8_t buttons;
+  int32_t x;
+  int32_t y;
+  int32_t wheel;
+  int32_t pan;
+  uint32_t dt;      // ms since the previous report
+  uint32_t repeat;  // identical reports following this one
+};
+#endif
+
+class HIDComposite : public Component
+#ifdef USE_HID_COMPOSITE_TEXT_STREAM
+    , public api::CustomAPIDevice
+#endif
+{
  public:
   void setup() override;
   void loop() override;
   void dump_config() override;
 
   // Mouse functions
-  void move(int8_t x, int8_t y);
-  void scroll(int8_t vertical, int8_t horizontal);
-  void click(MouseButton button);
+  // Values beyond MOUSE_DELTA_MAX are clamped
+  void move(int16_t x, int16_t y);
+  // In detents; fractions accumulate, see high_resolution_scroll
+  void scroll(float vertical, float horizontal);
+  // Velocities in detents per second, decaying by exp(-friction * t); stopped
+  // by any other scroll or pointer movement
+  void kinetic_scroll(float vertical, float horizontal, float friction);
+  void stop_kinetic_scroll();
+  // Non-blocking gestures, queued behind the ones still running. Keep-awake
+  // jiggles wait until the queue is empty.
+  void click(MouseButton button, std::function<void()> &&on_done = nullptr);
+  // interval_ms is the gap between the first release and the second press
+  void double_click(MouseButton button, uint32_t interval_ms, std::function<void()> &&on_done = nullptr);
+  // Moves by (x, y) over duration_ms with the button held
+  void drag(MouseButton button, int32_t x, int32_t y, uint32_t duration_ms,
+            std::function<void()> &&on_done = nullptr);
+  // Drops queued gestures and releases the buttons they hold
+  void stop_gestures();
+  bool is_gesture_active() const { return this->gesture_count_ > 0; }
   void mouse_press(MouseButton button);
   void mouse_release(MouseButton button);
   void mouse_release_all();
+  // Non-blocking: moves by (x, y) over duration_ms, one report per poll frame
+  void move_path(int32_t x, int32_t y, uint32_t duration_ms, const Easing &easing,
+                 std::function<void()> &&on_done = nullptr);
+  void stop_move_path();
+  bool is_moving() const { return this->path_active_; }
+  // Needs absolute_pointer: true; x and y span the screen from 0 to ABSOLUTE_MAX
+  void move_absolute(uint16_t x, uint16_t y);
+#ifdef USE_HID_COMPOSITE_BALLISTICS
+  // Non-blocking: moves the host pointer by (x, y) pixels, sizing each report
+  // through the host ballistics curve so it lands in as few reports as possible
+  void move_pixels(int32_t x, int32_t y, std::function<void()> &&on_done = nullptr);
+  void stop_move_pixels();
+  void add_ballistics_point(float counts, float pixels);
+#endif
+#ifdef USE_HID_COMPOSITE_RECORDING
+  // Captures every mouse report sent until stop_recording(), which saves it under name
+  void start_recording(const std::string &name);
+  void stop_recording();
+  // Non-blocking: replays a saved recording at its original pace
+  void replay(const std::string &name, std::function<void()> &&on_done = nullptr);
+  void stop_replay();
+#endif
 
-  // Keyboard functions
+  // Keyboard functions (keys are added to / removed from the pressed-key set)
   void key_press(const std::string &key, uint8_t modifier = 0);
   void key_release();
+  void key_release(const std::string &key);
   void key_release_all();
   void key_tap(const std::string &key, uint8_t modifier = 0);
-  void type(const std::string &text, uint32_t speed_ms = 50, uint32_t jitter_ms = 0);
+  // Keycode-based variants for keys resolved at compile time
+  void press_usage(uint8_t usage, uint8_t modifier = 0);
+  void release_usage(uint8_t usage, uint8_t modifier = 0);
+  void tap_usage(uint8_t usage, uint8_t modifier = 0);
+  void chord(const std::vector<uint8_t> &usages, uint8_t modifier = 0);
+  void chord(const std::vector<std::string> &keys, uint8_t modifier = 0);
+  void type(const std::string &text, uint32_t speed_ms = 50, uint32_t jitter_ms = 0, bool burst = false,
+            UnicodeMode unicode = UNICODE_NONE);
+  // Non-blocking: the file is streamed from loop(), on_done runs when it is typed
+  void type_file(const std::string &path, uint32_t speed_ms = 50, uint32_t jitter_ms = 0,
+                 UnicodeMode unicode = UNICODE_NONE, std::function<void()> &&on_done = nullptr);
+  // Non-blocking: types an LZSS-compressed text stored in flash (see lzss.py)
+  void type_compressed(const uint8_t *data, size_t len, uint32_t speed_ms = 50, uint32_t jitter_ms = 0,
+                       UnicodeMode unicode = UNICODE_NONE, std::function<void()> &&on_done = nullptr);
+  bool is_typing() const { return this->type_source_ != nullptr; }
+  void stop_typing();
+#ifdef USE_HID_COMPOSITE_SPIFFS
+  void set_spiffs(const std::string &partition, const std::string &base_path, bool format_if_mount_failed) {
+    this->spiffs_partition_ = partition;
+    this->spiffs_base_path_ = base_path;
+    this->spiffs_format_ = format_if_mount_failed;
+  }
+#endif
+#ifdef USE_HID_COMPOSITE_TEXT_STREAM
+  void set_text_stream(size_t buffer_size, uint32_t speed_ms, uint32_t jitter_ms, UnicodeMode unicode) {
+    this->stream_buffer_size_ = buffer_size;
+    this->stream_speed_ms_ = speed_ms;
+    this->stream_jitter_ms_ = jitter_ms;
+    this->stream_unicode_ = unicode;
+  }
+#endif
   
   // Layout
   void set_layout(KeyboardLayout layout) { this->layout_ = layout; }
@@ -91,6 +350,12 @@ class HIDComposite : public Component {
   void volume_up();
   void volume_down();
   
+  // Host keyboard LED state (Num/Caps/Scroll Lock)
+  uint8_t get_keyboard_leds() const { return this->keyboard_leds_; }
+  void add_on_keyboard_leds_callback(std::function<void(uint8_t)> &&callback) {
+    this->keyboard_leds_callbacks_.add(std::move(callback));
+  }
+
   // Telephony state getters
   bool is_muted() { return this->muted_; }
   bool is_off_hook() { return this->off_hook_; }
@@ -105,14 +370,212 @@ class HIDComposite : public Component {
   
   // Process host report (for telephony LED states) - Poly BT700 format with separate Report IDs
   void process_host_report(uint8_t report_id, uint8_t const *buffer, uint16_t bufsize);
+  // Feature reports (scroll resolution multiplier)
+  uint16_t get_feature_report(uint8_t report_id, uint8_t *buffer, uint16_t reqlen);
+  void process_feature_report(uint8_t report_id, uint8_t const *buffer, uint16_t bufsize);
 
  protected:
   bool initialized_{false};
   KeyboardLayout layout_{LAYOUT_QWERTY_US};
   uint8_t mouse_buttons_{0};
+  bool send_mouse_(int16_t x, int16_t y, int16_t wheel, int16_t pan);
+  bool send_jiggle_(int16_t x, int16_t y);
+  bool send_absolute_(uint16_t x, uint16_t y);
+  // Scroll state, in wheel units (see scroll())
+  uint8_t wheel_multiplier_{1};
+  uint8_t pan_multiplier_{1};
+  // Resolution multiplier feature byte (written from the USB task, applied in loop())
+  volatile uint8_t scroll_feature_{0};
+  void apply_scroll_feature_();
+  float scroll_remainder_v_{0};
+  float scroll_remainder_h_{0};
+  int32_t scroll_pending_v_{0};
+  int32_t scroll_pending_h_{0};
+  void flush_scroll_();
+
+  // Kinetic scroll: velocity (wheel units per frame) and position, 16.16 fixed point
+  bool kinetic_active_{false};
+  int32_t kinetic_velocity_v_{0};
+  int32_t kinetic_velocity_h_{0};
+  int32_t kinetic_position_v_{0};
+  int32_t kinetic_position_h_{0};
+  uint32_t kinetic_decay_{0};
+  uint32_t kinetic_last_{0};
+  HighFrequencyLoopRequester kinetic_high_freq_;
+  void process_kinetic_();
+  bool pointer_absolute_{false};
+  uint16_t absolute_x_{0};
+  uint16_t absolute_y_{0};
+
+  // Pointer path: progress along the easing curve is looked up in a table of
+  // curve points (16.16 fixed point) built once per path
+  bool path_active_{false};
+  int32_t path_x_{0};
+  int32_t path_y_{0};
+  int32_t path_sent_x_{0};
+  int32_t path_sent_y_{0};
+  uint32_t path_start_{0};
+  uint32_t path_duration_{0};
+  uint32_t path_curve_x_[PATH_CURVE_STEPS + 1];
+  int32_t path_curve_y_[PATH_CURVE_STEPS + 1];
+  std::function<void()> path_done_;
+  HighFrequencyLoopRequester path_high_freq_;
+  int32_t path_progress_(uint32_t t) const;
+  void process_path_();
+  void finish_path_();
+
+#ifdef USE_HID_COMPOSITE_BALLISTICS
+  // Pixel moves: the curve, and the pixels the host still has to travel
+  BallisticsPoint ballistics_[BALLISTICS_MAX_POINTS];
+  uint8_t ballistics_count_{0};
+  bool pixels_active_{false};
+  float pixels_remaining_x_{0};
+  float pixels_remaining_y_{0};
+  std::function<void()> pixels_done_;
+  HighFrequencyLoopRequester pixels_high_freq_;
+  float ballistics_pixels_(float counts) const;
+  float ballistics_counts_(float pixels) const;
+  void process_pixels_();
+  void finish_pixels_();
+#endif
+
+  // Gesture queue: a ring of steps; the head step runs once its buttons are sent
+  GestureStep gesture_steps_[GESTURE_QUEUE_SIZE];
+  uint8_t gesture_head_{0};
+  uint8_t gesture_count_{0};
+  bool gesture_step_started_{false};
+  uint32_t gesture_step_start_{0};
+  uint8_t gesture_buttons_{0};  // buttons currently held by gestures
+  HighFrequencyLoopRequester gesture_high_freq_;
+  void queue_gesture_(std::initializer_list<GestureStep> steps, std::function<void()> &&on_done);
+  void process_gesture_();
+  void finish_gestures_(bool notify);
+
+#ifdef USE_HID_COMPOSITE_RECORDING
+  // Recording: the last report is kept decoded so identical ones extend its run
+  bool recording_{false};
+  bool record_skip_{false};  // set while a keep-awake jiggle is sent
+  std::string record_name_;
+  std::vector<uint8_t> record_buffer_;
+  RecordedReport record_pending_{};
+  bool record_has_pending_{false};
+  uint32_t record_last_{0};
+  uint8_t record_buttons_{0};
+  uint32_t record_dt_{0};
+  void record_report_(bool absolute, int32_t x, int32_t y, int32_t wheel, int32_t pan);
+  bool record_flush_();
+
+  // Replay: reports are decoded one at a time from the loaded recording
+  bool replay_active_{false};
+  std::unique_ptr<MouseRecording> replay_data_;
+  size_t replay_pos_{0};
+  RecordedReport replay_report_{};
+  uint32_t replay_due_{0};
+  std::function<void()> replay_done_;
+  HighFrequencyLoopRequester replay_high_freq_;
+  bool replay_decode_();
+  void process_replay_();
+  void finish_replay_();
+#endif
+
+  // Pressed-key set
+  uint8_t held_modifiers_{0};
+  uint8_t held_keys_[KEYBOARD_ROLLOVER]{};
+  uint8_t held_key_mods_[KEYBOARD_ROLLOVER]{};
+  uint8_t held_count_{0};
+  bool hold_usage_(uint8_t usage, uint8_t modifier);
+  void drop_usage_(uint8_t usage, uint8_t modifier);
+  void send_held_keys_();
+  uint8_t resolve_key_(const std::string &key, uint8_t &modifier);
+
+  // Keys pressed by taps and chords, as (usage, modifier), released together
+  // by the "key_release" timeout instead of blocking the loop
+  std::vector<std::pair<uint8_t, uint8_t>> tap_release_;
+  void schedule_tap_release_(uint32_t delay_ms);
+  void release_taps_();
+
+  // Host keyboard LEDs (written from the USB task, published from loop())
+  volatile uint8_t keyboard_leds_{0};
+  volatile bool keyboard_leds_received_{false};
+  uint8_t keyboard_leds_published_{0};
+  bool num_lock_forced_{false};
+  CallbackManager<void(uint8_t)> keyboard_leds_callbacks_;
+  void layout_keycode_(uint32_t codepoint, uint8_t &keycode, uint8_t &modifier);
+
+  // Text to reports
+  // Modifier and key left held by the last compiled character
+  uint8_t compile_modifier_{0};
+  uint8_t compile_key_{0};
+  void start_text_();
+  uint8_t compile_codepoint_(uint32_t codepoint, UnicodeMode unicode, QueuedReport *out);
+  uint8_t end_text_(QueuedReport *out);
+  uint8_t unicode_reports_(uint32_t codepoint, UnicodeMode mode, QueuedReport *out);
+  uint8_t release_num_lock_(QueuedReport *out);
+  void compile_text_(const std::string &text, UnicodeMode unicode, std::vector<QueuedReport> &out);
+  void report_skipped_(size_t count, uint32_t first, UnicodeMode unicode);
+  void send_reports_(const QueuedReport *reports, size_t count, uint32_t speed_ms, uint32_t jitter_ms);
+
+  // Streaming typing engine
+  std::unique_ptr<TypeSource> type_source_;
+  std::function<void()> type_done_;
+  QueuedReport type_queue_[TYPE_QUEUE_SIZE];
+  uint8_t type_queue_head_{0};
+  uint8_t type_queue_count_{0};
+  char type_chunk_[TYPE_CHUNK_SIZE];
+  uint8_t type_chunk_pos_{0};
+  uint8_t type_chunk_len_{0};
+  Utf8Decoder type_decoder_;
+  bool type_source_done_{false};
+  uint32_t type_speed_ms_{50};
+  uint32_t type_jitter_ms_{0};
+  UnicodeMode type_unicode_mode_{UNICODE_NONE};
+  uint32_t type_next_report_{0};
+  uint8_t type_last_key_{0};
+  bool type_slot_release_pending_{false};
+  uint8_t type_slot_release_modifier_{0};
+  uint32_t type_slot_release_at_{0};
+  size_t type_skipped_{0};  // characters that could not be typed, reported when done
+  uint32_t type_first_skipped_{0};
+  HighFrequencyLoopRequester type_high_freq_;
+  bool start_typing_(std::unique_ptr<TypeSource> source, uint32_t speed_ms, uint32_t jitter_ms, UnicodeMode unicode,
+                     std::function<void()> &&on_done);
+  void finish_typing_();
+  void push_reports_(const QueuedReport *reports, uint8_t count);
+  void fill_type_queue_();
+  void process_type_queue_();
+
+#ifdef USE_HID_COMPOSITE_TEXT_STREAM
+  // Chunked text from the type_text_chunk API service, drained by the typing engine
+  TextRingBuffer stream_buffer_;
+  size_t stream_buffer_size_{2048};
+  uint32_t stream_speed_ms_{50};
+  uint32_t stream_jitter_ms_{0};
+  UnicodeMode stream_unicode_{UNICODE_NONE};
+  int32_t stream_next_seq_{0};
+  bool stream_active_{false};
+  bool stream_final_{false};
+  bool stream_blocked_{false};  // a chunk was refused for lack of room
+  void on_text_chunk_(int32_t seq, std::string text, bool final);
+  void send_stream_status_(int32_t seq, const char *status);
+#endif
+
+#ifdef USE_HID_COMPOSITE_SPIFFS
+  std::string spiffs_partition_;
+  std::string spiffs_base_path_;
+  bool spiffs_format_{false};
+#endif
 
   void send_mouse_report();
+  bool send_buttons_();
   void send_keyboard_report(uint8_t modifier, uint8_t keycode);
+  void send_keyboard_report(uint8_t modifier, const uint8_t *keycodes, uint8_t count);
+  void type_burst_(const std::string &text, uint32_t speed_ms, uint32_t jitter_ms, UnicodeMode unicode);
+  void send_burst_group_(uint8_t modifier, const uint8_t *keys, uint8_t count, uint32_t speed_ms, uint32_t jitter_ms,
+                         uint8_t next_key);
+  uint8_t hex_digit_keycode_(uint8_t nibble, bool keypad);
+  uint32_t type_delay_(uint32_t speed_ms, uint32_t jitter_ms, uint8_t from, uint8_t to);
+  hid_common::Xoshiro128 rng_;
+  hid_common::TypingModel typing_model_;
   void char_to_keycode(char c, uint8_t &keycode, uint8_t &modifier);
   void char_to_keycode_qwerty(char c, uint8_t &keycode, uint8_t &modifier);
   void char_to_keycode_azerty(char c, uint8_t &keycode, uint8_t &modifier);
@@ -125,10 +588,13 @@ class HIDComposite : public Component {
   uint32_t mouse_keep_awake_jitter_{0};
   uint32_t mouse_keep_awake_last_time_{0};
   uint32_t mouse_keep_awake_next_interval_{0};
+  int8_t mouse_keep_awake_return_x_{0};
+  int8_t mouse_keep_awake_return_y_{0};
   
   // Keyboard keep awake state
   bool keyboard_keep_awake_enabled_{false};
-  std::string keyboard_keep_awake_key_;
+  uint8_t keyboard_keep_awake_usage_{0};     // resolved once in start_keyboard_keep_awake()
+  uint8_t keyboard_keep_awake_modifier_{0};
   uint32_t keyboard_keep_awake_interval_{60000};
   uint32_t keyboard_keep_awake_jitter_{0};
   uint32_t keyboard_keep_awake_last_time_{0};
@@ -156,24 +622,80 @@ class HIDComposite : public Component {
 template<typename... Ts>
 class MoveAction : public Action<Ts...>, public Parented<HIDComposite> {
  public:
-  TEMPLATABLE_VALUE(int8_t, x)
-  TEMPLATABLE_VALUE(int8_t, y)
+  TEMPLATABLE_VALUE(int16_t, x)
+  TEMPLATABLE_VALUE(int16_t, y)
   void play(Ts... x) override { this->parent_->move(this->x_.value(x...), this->y_.value(x...)); }
 };
 
+template<typename... Ts>
+class MoveAbsoluteAction : public Action<Ts...>, public Parented<HIDComposite> {
+ public:
+  TEMPLATABLE_VALUE(uint16_t, x)
+  TEMPLATABLE_VALUE(uint16_t, y)
+  void play(Ts... x) override { this->parent_->move_absolute(this->x_.value(x...), this->y_.value(x...)); }
+};
+
+template<typename... Ts>
+class KineticScrollAction : public Action<Ts...>, public Parented<HIDComposite> {
+ public:
+  TEMPLATABLE_VALUE(float, vertical)
+  TEMPLATABLE_VALUE(float, horizontal)
+  TEMPLATABLE_VALUE(float, friction)
+  void play(Ts... x) override {
+    this->parent_->kinetic_scroll(this->vertical_.value(x...), this->horizontal_.value(x...),
+                                  this->friction_.value(x...));
+  }
+};
+
 template<typename... Ts>
 class ScrollAction : public Action<Ts...>, public Parented<HIDComposite> {
  public:
-  TEMPLATABLE_VALUE(int8_t, vertical)
-  TEMPLATABLE_VALUE(int8_t, horizontal)
+  TEMPLATABLE_VALUE(float, vertical)
+  TEMPLATABLE_VALUE(float, horizontal)
   void play(Ts... x) override { this->parent_->scroll(this->vertical_.value(x...), this->horizontal_.value(x...)); }
 };
 
+// Gestures run from the component loop; the next action starts once they end
 template<typename... Ts>
 class ClickAction : public Action<Ts...>, public Parented<HIDComposite> {
  public:
   TEMPLATABLE_VALUE(uint8_t, button)
-  void play(Ts... x) override { this->parent_->click(static_cast<MouseButton>(this->button_.value(x...))); }
+  void play_complex(Ts... x) override {
+    this->num_running_++;
+    this->parent_->click(static_cast<MouseButton>(this->button_.value(x...)), [this, x...]() { this->play_next_(x...); });
+  }
+  void play(Ts... x) override {}
+  void stop() override { this->parent_->stop_gestures(); }
+};
+
+template<typename... Ts>
+class DoubleClickAction : public Action<Ts...>, public Parented<HIDComposite> {
+ public:
+  TEMPLATABLE_VALUE(uint8_t, button)
+  TEMPLATABLE_VALUE(uint32_t, interval)
+  void play_complex(Ts... x) override {
+    this->num_running_++;
+    this->parent_->double_click(static_cast<MouseButton>(this->button_.value(x...)), this->interval_.value(x...),
+                                [this, x...]() { this->play_next_(x...); });
+  }
+  void play(Ts... x) override {}
+  void stop() override { this->parent_->stop_gestures(); }
+};
+
+template<typename... Ts>
+class DragAction : public Action<Ts...>, public Parented<HIDComposite> {
+ public:
+  TEMPLATABLE_VALUE(uint8_t, button)
+  TEMPLATABLE_VALUE(int32_t, x)
+  TEMPLATABLE_VALUE(int32_t, y)
+  TEMPLATABLE_VALUE(uint32_t, duration)
+  void play_complex(Ts... x) override {
+    this->num_running_++;
+    this->parent_->drag(static_cast<MouseButton>(this->button_.value(x...)), this->x_.value(x...),
+                        this->y_.value(x...), this->duration_.value(x...), [this, x...]() { this->play_next_(x...); });
+  }
+  void play(Ts... x) override {}
+  void stop() override { this->parent_->stop_gestures(); }
 };
 
 template<typename... Ts>
@@ -196,8 +718,74 @@ class MouseReleaseAllAction : public Action<Ts...>, public Parented<HIDComposite
   void play(Ts... x) override { this->parent_->mouse_release_all(); }
 };
 
+#ifdef USE_HID_COMPOSITE_RECORDING
+template<typename... Ts>
+class StartRecordingAction : public Action<Ts...>, public Parented<HIDComposite> {
+ public:
+  TEMPLATABLE_VALUE(std::string, name)
+  void play(Ts... x) override { this->parent_->start_recording(this->name_.value(x...)); }
+};
+
+template<typename... Ts>
+class StopRecordingAction : public Action<Ts...>, public Parented<HIDComposite> {
+ public:
+  void play(Ts... x) override { this->parent_->stop_recording(); }
+};
+
+// The recording plays from the component loop; the next action starts once it ends
+template<typename... Ts>
+class ReplayAction : public Action<Ts...>, public Parented<HIDComposite> {
+ public:
+  TEMPLATABLE_VALUE(std::string, name)
+  void play_complex(Ts... x) override {
+    this->num_running_++;
+    this->parent_->replay(this->name_.value(x...), [this, x...]() { this->play_next_(x...); });
+  }
+  void play(Ts... x) override {}
+  void stop() override { this->parent_->stop_replay(); }
+};
+#endif
+
+// The pointer moves from the component loop; the next action starts once it arrives
+template<typename... Ts>
+class MovePathAction : public Action<Ts...>, public Parented<HIDComposite> {
+ public:
+  TEMPLATABLE_VALUE(int32_t, x)
+  TEMPLATABLE_VALUE(int32_t, y)
+  TEMPLATABLE_VALUE(uint32_t, duration)
+  void set_easing(float x1, float y1, float x2, float y2) { this->easing_ = {x1, y1, x2, y2}; }
+  void play_complex(Ts... x) override {
+    this->num_running_++;
+    this->parent_->move_path(this->x_.value(x...), this->y_.value(x...), this->duration_.value(x...), this->easing_,
+                             [this, x...]() { this->play_next_(x...); });
+  }
+  void play(Ts... x) override {}
+  void stop() override { this->parent_->stop_move_path(); }
+
+ protected:
+  Easing easing_{0.42f, 0.0f, 0.58f, 1.0f};
+};
+
+#ifdef USE_HID_COMPOSITE_BALLISTICS
+// The pointer moves from the component loop; the next action starts once it lands
+template<typename... Ts>
+class MovePixelsAction : public Action<Ts...>, public Parented<HIDComposite> {
+ public:
+  TEMPLATABLE_VALUE(int32_t, x)
+  TEMPLATABLE_VALUE(int32_t, y)
+  void play_complex(Ts... x) override {
+    this->num_running_++;
+    this->parent_->move_pixels(this->x_.value(x...), this->y_.value(x...), [this, x...]() { this->play_next_(x...); });
+  }
+  void play(Ts... x) override {}
+  void stop() override { this->parent_->stop_move_pixels(); }
+};
+#endif
+
 // ============ Keyboard Action Templates ============
 
+// Keys given as lambdas (or characters left to a runtime layout) are resolved
+// when the action runs; literal keys use the *UsageAction classes below
 template<typename... Ts>
 class KeyPressAction : public Action<Ts...>, public Parented<HIDComposite> {
  public:
@@ -211,7 +799,14 @@ class KeyPressAction : public Action<Ts...>, public Parented<HIDComposite> {
 template<typename... Ts>
 class KeyReleaseAction : public Action<Ts...>, public Parented<HIDComposite> {
  public:
-  void play(Ts... x) override { this->parent_->key_release(); }
+  TEMPLATABLE_VALUE(std::string, key)
+  void play(Ts... x) override {
+    if (this->key_.has_value()) {
+      this->parent_->key_release(this->key_.value(x...));
+    } else {
+      this->parent_->key_release();
+    }
+  }
 };
 
 template<typename... Ts>
@@ -224,21 +819,122 @@ class KeyTapAction : public Action<Ts...>, public Parented<HIDComposite> {
   uint8_t modifier_{0};
 };
 
+// Literal keys, resolved by the codegen to a HID usage and its implied modifier
+template<typename... Ts>
+class KeyPressUsageAction : public Action<Ts...>, public Parented<HIDComposite> {
+ public:
+  void set_usage(uint8_t usage) { this->usage_ = usage; }
+  void set_modifier(uint8_t mod) { this->modifier_ = mod; }
+  void play(Ts... x) override { this->parent_->press_usage(this->usage_, this->modifier_); }
+ protected:
+  uint8_t usage_{0};
+  uint8_t modifier_{0};
+};
+
+template<typename... Ts>
+class KeyReleaseUsageAction : public Action<Ts...>, public Parented<HIDComposite> {
+ public:
+  void set_usage(uint8_t usage) { this->usage_ = usage; }
+  void set_modifier(uint8_t mod) { this->modifier_ = mod; }
+  void play(Ts... x) override { this->parent_->release_usage(this->usage_, this->modifier_); }
+ protected:
+  uint8_t usage_{0};
+  uint8_t modifier_{0};
+};
+
+template<typename... Ts>
+class KeyTapUsageAction : public Action<Ts...>, public Parented<HIDComposite> {
+ public:
+  void set_usage(uint8_t usage) { this->usage_ = usage; }
+  void set_modifier(uint8_t mod) { this->modifier_ = mod; }
+  void play(Ts... x) override { this->parent_->tap_usage(this->usage_, this->modifier_); }
+ protected:
+  uint8_t usage_{0};
+  uint8_t modifier_{0};
+};
+
+template<typename... Ts>
+class ChordAction : public Action<Ts...>, public Parented<HIDComposite> {
+ public:
+  void set_usages(const std::vector<uint8_t> &usages) { this->usages_ = usages; }
+  void set_keys(const std::vector<std::string> &keys) { this->keys_ = keys; }
+  void set_modifier(uint8_t mod) { this->modifier_ = mod; }
+  void play(Ts... x) override {
+    if (this->keys_.empty()) {
+      this->parent_->chord(this->usages_, this->modifier_);
+    } else {
+      this->parent_->chord(this->keys_, this->modifier_);
+    }
+  }
+ protected:
+  std::vector<uint8_t> usages_;
+  std::vector<std::string> keys_;
+  uint8_t modifier_{0};
+};
+
 template<typename... Ts>
 class KeyReleaseAllAction : public Action<Ts...>, public Parented<HIDComposite> {
  public:
   void play(Ts... x) override { this->parent_->key_release_all(); }
 };
 
+// Long literal texts are stored compressed in flash by the codegen and typed
+// from the component loop while they are decompressed; the next action starts
+// once the text is typed. Other texts (short literals, lambdas, burst) are typed
+// by type() inside play(), which blocks the main loop until the last report.
 template<typename... Ts>
 class TypeAction : public Action<Ts...>, public Parented<HIDComposite> {
  public:
   TEMPLATABLE_VALUE(std::string, text)
   TEMPLATABLE_VALUE(uint32_t, speed)
   TEMPLATABLE_VALUE(uint32_t, jitter)
+  TEMPLATABLE_VALUE(bool, burst)
+  void set_data(const uint8_t *data, size_t len) {
+    this->data_ = data;
+    this->len_ = len;
+  }
+  void set_unicode(UnicodeMode unicode) { this->unicode_ = unicode; }
+  void play_complex(Ts... x) override {
+    if (this->data_ == nullptr) {
+      Action<Ts...>::play_complex(x...);
+      return;
+    }
+    this->num_running_++;
+    this->parent_->type_compressed(this->data_, this->len_, this->speed_.value(x...), this->jitter_.value(x...),
+                                   this->unicode_, [this, x...]() { this->play_next_(x...); });
+  }
   void play(Ts... x) override {
-    this->parent_->type(this->text_.value(x...), this->speed_.value(x...), this->jitter_.value(x...));
+    this->parent_->type(this->text_.value(x...), this->speed_.value(x...), this->jitter_.value(x...),
+                        this->burst_.value(x...), this->unicode_);
+  }
+  void stop() override {
+    if (this->data_ != nullptr) this->parent_->stop_typing();
+  }
+
+ protected:
+  const uint8_t *data_{nullptr};
+  size_t len_{0};
+  UnicodeMode unicode_{UNICODE_NONE};
+};
+
+// Typing runs from the component loop; the next action starts once the file is typed
+template<typename... Ts>
+class TypeFileAction : public Action<Ts...>, public Parented<HIDComposite> {
+ public:
+  TEMPLATABLE_VALUE(std::string, path)
+  TEMPLATABLE_VALUE(uint32_t, speed)
+  TEMPLATABLE_VALUE(uint32_t, jitter)
+  void set_unicode(UnicodeMode unicode) { this->unicode_ = unicode; }
+  void play_complex(Ts... x) override {
+    this->num_running_++;
+    this->parent_->type_file(this->path_.value(x...), this->speed_.value(x...), this->jitter_.value(x...),
+                             this->unicode_, [this, x...]() { this->play_next_(x...); });
   }
+  void play(Ts... x) override {}
+  void stop() override { this->parent_->stop_typing(); }
+
+ protected:
+  UnicodeMode unicode_{UNICODE_NONE};
 };
 
 // ============ Keep Awake Action Templates ============
@@ -0,0 +1,75 @@
+"""LZSS compression for literal texts stored in flash.
+
+Decoded on the device by LzssTypeSource in hid_composite.cpp; the constants
+must match LZSS_WINDOW_BITS / LZSS_LENGTH_BITS / LZSS_MIN_MATCH in
+hid_composite.h.
+
+Format: a flag byte announces the next eight items, least significant bit
+first. A set bit is a literal byte, a clear bit a 16-bit big-endian match
+token: (distance - 1) in the top WINDOW_BITS bits, (length - MIN_MATCH) in the
+low LENGTH_BITS bits. Matches may overlap the bytes they produce.
+"""
+
+WINDOW_BITS = 9
+LENGTH_BITS = 7
+MIN_MATCH = 3
+
+WINDOW_SIZE = 1 << WINDOW_BITS
+MAX_MATCH = MIN_MATCH + (1 << LENGTH_BITS) - 1
+
+
+def compress(data: bytes) -> bytes:
+    out = bytearray()
+    # Positions of every 3-byte prefix seen so far, oldest first
+    prefixes = {}
+    i = 0
+    while i < len(data):
+        flags_index = len(out)
+        out.append(0)
+        for bit in range(8):
+            if i >= len(data):
+                break
+            best_len, best_dist = 0, 0
+            for j in reversed(prefixes.get(data[i:i + MIN_MATCH], ())):
+                if i - j > WINDOW_SIZE:
+                    break
+                length = MIN_MATCH
+                while length < MAX_MATCH and i + length < len(data) and data[j + length] == data[i + length]:
+                    length += 1
+                if length > best_len:
+                    best_len, best_dist = length, i - j
+                    if length == MAX_MATCH:
+                        break
+            if best_len:
+                token = ((best_dist - 1) << LENGTH_BITS) | (best_len - MIN_MATCH)
+                out += token.to_bytes(2, "big")
+            else:
+                out[flags_index] |= 1 << bit
+                out.append(data[i])
+                best_len = 1
+            for k in range(i, i + best_len):
+                prefixes.setdefault(data[k:k + MIN_MATCH], []).append(k)
+            i += best_len
+    return bytes(out)
+
+
+def decompress(data: bytes) -> bytes:
+    """Reference decoder, used to check the output at build time."""
+    out = bytearray()
+    pos = 0
+    while pos < len(data):
+        flags = data[pos]
+        pos += 1
+        for bit in range(8):
+            if pos >= len(data):
+                break
+            if flags & (1 << bit):
+                out.append(data[pos])
+                pos += 1
+                continue
+            token = int.from_bytes(data[pos:pos + 2], "big")
+            pos += 2
+            dist = (token >> LENGTH_BITS) + 1
+            for _ in range((token & ((1 << LENGTH_BITS) - 1)) + MIN_MATCH):
+                out.append(out[-dist])
+    return bytes(out)
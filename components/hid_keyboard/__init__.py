@@ -1,15 +1,20 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
+import esphome.final_validate as fv
 from esphome import automation
+from esphome.components.hid_common.keymaps import KEY_NAMES
 from esphome.const import CONF_ID
 
 DEPENDENCIES = ["esp32"]
+AUTO_LOAD = ["hid_common"]
 CODEOWNERS = ["@AntorFr"]
 
 # Cannot be used with hid_mouse or hid_composite (each configures USB)
 CONFLICTS_WITH = ["hid_mouse", "hid_composite"]
 
 CONF_LAYOUT = "layout"
+CONF_RUNTIME_LAYOUT = "runtime_layout"
+CONF_NKRO = "nkro"
 
 hid_keyboard_ns = cg.esphome_ns.namespace("hid_keyboard")
 HIDKeyboard = hid_keyboard_ns.class_("HIDKeyboard", cg.Component)
@@ -27,6 +32,7 @@ PressAction = hid_keyboard_ns.class_("PressAction", automation.Action)
 ReleaseAction = hid_keyboard_ns.class_("ReleaseAction", automation.Action)
 TapAction = hid_keyboard_ns.class_("TapAction", automation.Action)
 TypeAction = hid_keyboard_ns.class_("TypeAction", automation.Action)
+ChordAction = hid_keyboard_ns.class_("ChordAction", automation.Action)
 ReleaseAllAction = hid_keyboard_ns.class_("ReleaseAllAction", automation.Action)
 StartKeepAwakeAction = hid_keyboard_ns.class_("StartKeepAwakeAction", automation.Action)
 StopKeepAwakeAction = hid_keyboard_ns.class_("StopKeepAwakeAction", automation.Action)
@@ -35,6 +41,9 @@ CONFIG_SCHEMA = cv.Schema(
     {
         cv.GenerateID(): cv.declare_id(HIDKeyboard),
         cv.Optional(CONF_LAYOUT, default="QWERTY_US"): cv.enum(KEYBOARD_LAYOUTS, upper=True),
+        # Keep every layout compiled in so set_layout() can switch at runtime
+        cv.Optional(CONF_RUNTIME_LAYOUT, default=False): cv.boolean,
+        cv.Optional(CONF_NKRO, default=False): cv.boolean,
     }
 ).extend(cv.COMPONENT_SCHEMA)
 
@@ -43,12 +52,17 @@ async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
     cg.add(var.set_layout(config[CONF_LAYOUT]))
+    if not config[CONF_RUNTIME_LAYOUT]:
+        cg.add_define(f"USE_HID_KEYBOARD_LAYOUT_{config[CONF_LAYOUT]}")
+    if config[CONF_NKRO]:
+        cg.add_define("USE_HID_KEYBOARD_NKRO")
 
 
 CONF_KEY = "key"
 CONF_TEXT = "text"
 CONF_MODIFIER = "modifier"
 CONF_INTERVAL = "interval"
+CONF_KEYS = "keys"
 
 MODIFIERS = {
     "NONE": 0x00,
@@ -95,12 +109,16 @@ async def press_action_to_code(config, action_id, template_arg, args):
     cv.Schema(
         {
             cv.GenerateID(): cv.use_id(HIDKeyboard),
+            cv.Optional(CONF_KEY): cv.templatable(cv.string),
         }
     ),
 )
 async def release_action_to_code(config, action_id, template_arg, args):
     var = cg.new_Pvariable(action_id, template_arg)
     await cg.register_parented(var, config[CONF_ID])
+    if CONF_KEY in config:
+        template_ = await cg.templatable(config[CONF_KEY], args, cg.std_string)
+        cg.add(var.set_key(template_))
     return var
 
 
@@ -124,6 +142,38 @@ async def tap_action_to_code(config, action_id, template_arg, args):
     return var
 
 
+@automation.register_action(
+    "hid_keyboard.chord",
+    ChordAction,
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.use_id(HIDKeyboard),
+            cv.Required(CONF_KEYS): cv.All(cv.ensure_list(cv.string), cv.Length(min=1)),
+            cv.Optional(CONF_MODIFIER, default="NONE"): cv.enum(MODIFIERS, upper=True),
+        }
+    ),
+)
+async def chord_action_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    cg.add(var.set_keys(config[CONF_KEYS]))
+    cg.add(var.set_modifier(config[CONF_MODIFIER]))
+    return var
+
+
+def final_validate_chord(config, action):
+    # Modifier keys are folded into the modifier byte; every other key takes a
+    # report slot, and the report holds KEYBOARD_ROLLOVER of them
+    slots = {key if len(key) == 1 else key.upper() for key in action[CONF_KEYS]
+             if len(key) == 1 or not 0xE0 <= KEY_NAMES.get(key.upper(), 0) <= 0xE7}
+    rollover = 16 if config[CONF_NKRO] else 6
+    if len(slots) > rollover:
+        raise cv.Invalid(
+            f"A chord holds at most {rollover} keys besides modifiers"
+            + ("" if config[CONF_NKRO] else " (16 with nkro: true)")
+        )
+
+
 @automation.register_action(
     "hid_keyboard.release_all",
     ReleaseAllAction,
@@ -205,3 +255,25 @@ async def stop_keep_awake_action_to_code(config, action_id, template_arg, args):
     var = cg.new_Pvariable(action_id, template_arg)
     await cg.register_parented(var, config[CONF_ID])
     return var
+
+
+def iter_actions(value, name):
+    if isinstance(value, dict):
+        for key, item in value.items():
+            if key == name:
+                yield item
+            else:
+                yield from iter_actions(item, name)
+    elif isinstance(value, list):
+        for item in value:
+            yield from iter_actions(item, name)
+
+
+# Actions are validated before the hid_keyboard block is, so the checks that
+# depend on its options run here
+def final_validate(config):
+    for action in iter_actions(fv.full_config.get(), "hid_keyboard.chord"):
+        final_validate_chord(config, action)
+
+
+FINAL_VALIDATE_SCHEMA = final_validate
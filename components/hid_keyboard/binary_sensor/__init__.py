@@ -1,7 +1,7 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import binary_sensor
-from esphome.const import CONF_ID, DEVICE_CLASS_CONNECTIVITY
+from esphome.const import CONF_ID, CONF_TYPE, DEVICE_CLASS_CONNECTIVITY
 
 from .. import hid_keyboard_ns, HIDKeyboard
 
@@ -13,15 +13,40 @@ CONF_HID_KEYBOARD_ID = "hid_keyboard_id"
 HIDConnectedBinarySensor = hid_keyboard_ns.class_(
     "HIDConnectedBinarySensor", binary_sensor.BinarySensor, cg.PollingComponent
 )
+HIDKeyboardLedBinarySensor = hid_keyboard_ns.class_(
+    "HIDKeyboardLedBinarySensor", binary_sensor.BinarySensor, cg.Component
+)
+
+# Host keyboard LED bits (see KeyboardLed)
+KEYBOARD_LEDS = {
+    "num_lock": 0x01,
+    "caps_lock": 0x02,
+    "scroll_lock": 0x04,
+}
 
-CONFIG_SCHEMA = binary_sensor.binary_sensor_schema(
-    HIDConnectedBinarySensor,
-    device_class=DEVICE_CLASS_CONNECTIVITY,
-).extend(
+CONFIG_SCHEMA = cv.typed_schema(
     {
-        cv.GenerateID(CONF_HID_KEYBOARD_ID): cv.use_id(HIDKeyboard),
-    }
-).extend(cv.polling_component_schema("1s"))
+        "connected": binary_sensor.binary_sensor_schema(
+            HIDConnectedBinarySensor,
+            device_class=DEVICE_CLASS_CONNECTIVITY,
+        ).extend(
+            {
+                cv.GenerateID(CONF_HID_KEYBOARD_ID): cv.use_id(HIDKeyboard),
+            }
+        ).extend(cv.polling_component_schema("1s")),
+        **{
+            led: binary_sensor.binary_sensor_schema(
+                HIDKeyboardLedBinarySensor,
+            ).extend(
+                {
+                    cv.GenerateID(CONF_HID_KEYBOARD_ID): cv.use_id(HIDKeyboard),
+                }
+            ).extend(cv.COMPONENT_SCHEMA)
+            for led in KEYBOARD_LEDS
+        },
+    },
+    default_type="connected",
+)
 
 
 async def to_code(config):
@@ -30,3 +55,5 @@ async def to_code(config):
     
     parent = await cg.get_variable(config[CONF_HID_KEYBOARD_ID])
     cg.add(var.set_parent(parent))
+    if config[CONF_TYPE] in KEYBOARD_LEDS:
+        cg.add(var.set_led(KEYBOARD_LEDS[config[CONF_TYPE]]))
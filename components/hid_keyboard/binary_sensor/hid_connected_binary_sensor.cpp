@@ -15,5 +15,17 @@ void HIDConnectedBinarySensor::update() {
   this->publish_state(connected);
 }
 
+void HIDKeyboardLedBinarySensor::setup() {
+  this->publish_state((this->parent_->get_leds() & this->led_) != 0);
+  this->parent_->add_on_leds_callback([this](uint8_t leds) {
+    this->publish_state((leds & this->led_) != 0);
+  });
+}
+
+void HIDKeyboardLedBinarySensor::dump_config() {
+  LOG_BINARY_SENSOR("", "HID Keyboard LED", this);
+  ESP_LOGCONFIG(TAG, "  LED mask: 0x%02X", this->led_);
+}
+
 }  // namespace hid_keyboard
 }  // namespace esphome
@@ -19,5 +19,18 @@ class HIDConnectedBinarySensor : public binary_sensor::BinarySensor, public Poll
   HIDKeyboard *parent_{nullptr};
 };
 
+class HIDKeyboardLedBinarySensor : public binary_sensor::BinarySensor, public Component {
+ public:
+  void setup() override;
+  void dump_config() override;
+  
+  void set_parent(HIDKeyboard *parent) { this->parent_ = parent; }
+  void set_led(uint8_t led) { this->led_ = led; }
+
+ protected:
+  HIDKeyboard *parent_{nullptr};
+  uint8_t led_{LED_CAPS_LOCK};
+};
+
 }  // namespace hid_keyboard
 }  // namespace esphome
@@ -1,6 +1,7 @@
 #include "hid_keyboard.h"
 #include "esphome/core/log.h"
 #include "esphome/core/hal.h"
+#include "esphome/components/hid_common/key_names.h"
 
 #ifdef USE_ESP32
 
@@ -35,8 +36,20 @@ enum KeyCode : uint8_t {
   KEY_INSERT = 0x49, KEY_HOME = 0x4A, KEY_PAGE_UP = 0x4B,
   KEY_DELETE = 0x4C, KEY_END = 0x4D, KEY_PAGE_DOWN = 0x4E,
   KEY_RIGHT_ARROW = 0x4F, KEY_LEFT_ARROW = 0x50, KEY_DOWN_ARROW = 0x51, KEY_UP_ARROW = 0x52,
+  KEY_LEFT_CTRL = 0xE0, KEY_RIGHT_GUI = 0xE7,
 };
 
+// Keyboard report layout. The NKRO bitmap report is not boot-protocol
+// compatible, so the interface is declared as a plain HID device in that mode.
+#ifdef USE_HID_KEYBOARD_NKRO
+static const uint8_t KEYBOARD_REPORT_SIZE = 29;  // modifiers + bitmap of usages 0x00-0xDF
+static const uint8_t KEYBOARD_ITF_PROTOCOL = HID_ITF_PROTOCOL_NONE;
+static_assert(CFG_TUD_HID_EP_BUFSIZE >= KEYBOARD_REPORT_SIZE, "NKRO report does not fit CFG_TUD_HID_EP_BUFSIZE");
+#else
+static const uint8_t KEYBOARD_REPORT_SIZE = 8;   // modifiers + reserved + 6 keys
+static const uint8_t KEYBOARD_ITF_PROTOCOL = HID_ITF_PROTOCOL_KEYBOARD;
+#endif
+
 // HID Report Descriptor for Keyboard
 static const uint8_t hid_report_descriptor[] = {
     0x05, 0x01,        // Usage Page (Generic Desktop)
@@ -53,10 +66,12 @@ static const uint8_t hid_report_descriptor[] = {
     0x95, 0x08,        //   Report Count (8)
     0x81, 0x02,        //   Input (Data, Variable, Absolute)
     
+#ifndef USE_HID_KEYBOARD_NKRO
     // Reserved byte
     0x95, 0x01,        //   Report Count (1)
     0x75, 0x08,        //   Report Size (8)
     0x81, 0x01,        //   Input (Constant)
+#endif
     
     // LEDs
     0x95, 0x05,        //   Report Count (5)
@@ -69,15 +84,27 @@ static const uint8_t hid_report_descriptor[] = {
     0x75, 0x03,        //   Report Size (3)
     0x91, 0x01,        //   Output (Constant)
     
+#ifdef USE_HID_KEYBOARD_NKRO
+    // Key bitmap (N-key rollover): one bit per usage 0x00-0xDF
+    0x05, 0x07,        //   Usage Page (Keyboard)
+    0x19, 0x00,        //   Usage Minimum (0)
+    0x29, 0xDF,        //   Usage Maximum (223)
+    0x15, 0x00,        //   Logical Minimum (0)
+    0x25, 0x01,        //   Logical Maximum (1)
+    0x75, 0x01,        //   Report Size (1)
+    0x96, 0xE0, 0x00,  //   Report Count (224)
+    0x81, 0x02,        //   Input (Data, Variable, Absolute)
+#else
     // Key codes
     0x95, 0x06,        //   Report Count (6)
     0x75, 0x08,        //   Report Size (8)
     0x15, 0x00,        //   Logical Minimum (0)
-    0x25, 0x65,        //   Logical Maximum (101)
+    0x26, 0xE7, 0x00,  //   Logical Maximum (231)
     0x05, 0x07,        //   Usage Page (Keyboard)
     0x19, 0x00,        //   Usage Minimum (0)
-    0x29, 0x65,        //   Usage Maximum (101)
+    0x29, 0xE7,        //   Usage Maximum (231)
     0x81, 0x00,        //   Input (Data, Array)
+#endif
     
     0xC0,              // End Collection
 };
@@ -111,18 +138,27 @@ static const char *string_descriptors[] = {
 
 static const uint8_t configuration_descriptor[] = {
     TUD_CONFIG_DESCRIPTOR(1, 1, 0, CONFIG_TOTAL_LEN, TUSB_DESC_CONFIG_ATT_REMOTE_WAKEUP, 100),
-    TUD_HID_DESCRIPTOR(0, 0, HID_ITF_PROTOCOL_KEYBOARD, sizeof(hid_report_descriptor), EPNUM_HID, CFG_TUD_HID_EP_BUFSIZE, 10),
+    TUD_HID_DESCRIPTOR(0, 0, KEYBOARD_ITF_PROTOCOL, sizeof(hid_report_descriptor), EPNUM_HID, CFG_TUD_HID_EP_BUFSIZE, 10),
 };
 
+// Global instance pointer for the TinyUSB callbacks
+static HIDKeyboard *g_hid_keyboard_instance = nullptr;
+
 extern "C" {
 uint8_t const *tud_hid_descriptor_report_cb(uint8_t instance) { return hid_report_descriptor; }
 uint16_t tud_hid_get_report_cb(uint8_t instance, uint8_t report_id, hid_report_type_t report_type, uint8_t *buffer, uint16_t reqlen) { return 0; }
-void tud_hid_set_report_cb(uint8_t instance, uint8_t report_id, hid_report_type_t report_type, uint8_t const *buffer, uint16_t bufsize) {}
+void tud_hid_set_report_cb(uint8_t instance, uint8_t report_id, hid_report_type_t report_type, uint8_t const *buffer, uint16_t bufsize) {
+  if (report_type == HID_REPORT_TYPE_OUTPUT && g_hid_keyboard_instance != nullptr) {
+    g_hid_keyboard_instance->process_host_report(buffer, bufsize);
+  }
+}
 }
 
 void HIDKeyboard::setup() {
   ESP_LOGI(TAG, "Setting up HID Keyboard...");
   
+  g_hid_keyboard_instance = this;
+  
   tinyusb_config_t tusb_cfg = {
     .port = TINYUSB_PORT_FULL_SPEED_0,
     .phy = { .skip_setup = false, .self_powered = false, .vbus_monitor_io = -1, },
@@ -148,63 +184,298 @@ void HIDKeyboard::setup() {
   this->initialized_ = true;
 }
 
-void HIDKeyboard::loop() {}
+void HIDKeyboard::loop() {
+  if (!this->initialized_) return;
+
+  // Keep awake: the key was resolved when keep awake started, and the release is
+  // scheduled instead of blocking. Held keys already keep the host awake, so the
+  // tap waits until the keyboard is idle.
+  uint32_t now = millis();
+  bool busy = this->held_count_ > 0 || !this->tap_release_.empty();
+  if (this->keep_awake_enabled_ && !busy && now - this->keep_awake_last_time_ >= this->keep_awake_next_interval_) {
+    if (this->hold_key_(this->keep_awake_keycode_, this->keep_awake_modifier_)) this->send_held_keys_();
+    this->set_timeout("keep_awake", 10, [this]() {
+      this->drop_key_(this->keep_awake_keycode_, this->keep_awake_modifier_);
+      this->send_held_keys_();
+    });
+    ESP_LOGV(TAG, "Keep awake: tap(0x%02X)", this->keep_awake_keycode_);
+
+    this->keep_awake_next_interval_ = this->keep_awake_interval_;
+    if (this->keep_awake_jitter_ > 0) {
+      int32_t jitter = this->rng_.symmetric(this->keep_awake_jitter_);
+      this->keep_awake_next_interval_ = (int32_t)this->keep_awake_interval_ + jitter > 1000
+                                        ? this->keep_awake_interval_ + jitter : 1000;
+    }
+    this->keep_awake_last_time_ = now;
+  }
+
+  // Host LED changes arrive on the USB task; publish them from the main loop
+  uint8_t leds = this->leds_;
+  if (leds != this->leds_published_) {
+    this->leds_published_ = leds;
+    this->leds_callbacks_.call(leds);
+  }
+}
+
+// The only output report is the LED byte: bit 0 = Num Lock, bit 1 = Caps Lock, bit 2 = Scroll Lock
+void HIDKeyboard::process_host_report(uint8_t const *buffer, uint16_t bufsize) {
+  if (bufsize < 1) return;
+  ESP_LOGD(TAG, "LED report: 0x%02X", buffer[0]);
+  this->leds_ = buffer[0];
+}
 
 void HIDKeyboard::dump_config() {
   ESP_LOGCONFIG(TAG, "HID Keyboard:");
   ESP_LOGCONFIG(TAG, "  Status: %s", this->initialized_ ? "Initialized" : "Not initialized");
+#ifdef HID_KEYBOARD_RUNTIME_LAYOUT
+  ESP_LOGCONFIG(TAG, "  Layout: %d (runtime switchable)", this->layout_);
+#else
+  ESP_LOGCONFIG(TAG, "  Layout: %d (fixed at compile time)", this->layout_);
+#endif
+#ifdef USE_HID_KEYBOARD_NKRO
+  ESP_LOGCONFIG(TAG, "  Report: NKRO (%d bytes)", KEYBOARD_REPORT_SIZE);
+#else
+  ESP_LOGCONFIG(TAG, "  Report: 6KRO (%d bytes)", KEYBOARD_REPORT_SIZE);
+#endif
 }
 
 void HIDKeyboard::send_report(uint8_t modifier, uint8_t keycode) {
+  this->send_report(modifier, &keycode, keycode == KEY_NONE ? 0 : 1);
+}
+
+void HIDKeyboard::send_report(uint8_t modifier, const uint8_t *keycodes, uint8_t count) {
   if (!this->initialized_ || !tud_mounted() || !tud_hid_ready()) return;
-  uint8_t keycodes[6] = {keycode, 0, 0, 0, 0, 0};
-  tud_hid_keyboard_report(0, modifier, keycodes);
-  ESP_LOGD(TAG, "Report: mod=0x%02X key=0x%02X", modifier, keycode);
+#ifdef USE_HID_KEYBOARD_NKRO
+  uint8_t report[KEYBOARD_REPORT_SIZE] = {modifier};
+  for (uint8_t i = 0; i < count; i++) {
+    uint8_t key = keycodes[i];
+    if (key < KEY_LEFT_CTRL) report[1 + (key >> 3)] |= 1 << (key & 7);
+  }
+  tud_hid_report(0, report, sizeof(report));
+#else
+  uint8_t keys[6] = {0, 0, 0, 0, 0, 0};
+  for (uint8_t i = 0; i < count && i < 6; i++) keys[i] = keycodes[i];
+  tud_hid_keyboard_report(0, modifier, keys);
+#endif
+  ESP_LOGV(TAG, "Report: mod=0x%02X keys=%d first=0x%02X", modifier, count, count ? keycodes[0] : 0);
 }
 
-void HIDKeyboard::press(const std::string &key, uint8_t modifier) {
-  uint8_t keycode, char_mod;
+uint8_t HIDKeyboard::resolve_key_(const std::string &key, uint8_t &modifier) {
+  uint8_t keycode;
   if (key.length() == 1) {
-    this->char_to_keycode(key[0], keycode, char_mod);
+    this->char_to_keycode(key[0], keycode, modifier);
   } else {
     keycode = this->key_name_to_keycode(key);
-    char_mod = 0;
+    modifier = 0;
+  }
+  return keycode;
+}
+
+// Pressed-key state. Each held key keeps the modifier it was pressed with, so
+// releasing it drops that modifier too; modifier keys (LEFT_CTRL..RIGHT_GUI) go in
+// the modifier byte, not the key array. Every report is rebuilt from this set.
+bool HIDKeyboard::hold_key_(uint8_t keycode, uint8_t modifier) {
+  if (keycode >= KEY_LEFT_CTRL && keycode <= KEY_RIGHT_GUI) {
+    this->held_modifiers_ |= modifier | (1 << (keycode - KEY_LEFT_CTRL));
+    return true;
+  }
+  if (keycode == KEY_NONE) {
+    this->held_modifiers_ |= modifier;
+    return true;
+  }
+  for (uint8_t i = 0; i < this->held_count_; i++) {
+    if (this->held_keys_[i] == keycode) {
+      this->held_key_mods_[i] = modifier;
+      return true;
+    }
+  }
+  if (this->held_count_ == KEYBOARD_ROLLOVER) {
+    ESP_LOGW(TAG, "Cannot hold key 0x%02X: %d keys already pressed", keycode, KEYBOARD_ROLLOVER);
+    return false;
   }
+  this->held_keys_[this->held_count_] = keycode;
+  this->held_key_mods_[this->held_count_] = modifier;
+  this->held_count_++;
+  return true;
+}
+
+void HIDKeyboard::drop_key_(uint8_t keycode, uint8_t modifier) {
+  if (keycode >= KEY_LEFT_CTRL && keycode <= KEY_RIGHT_GUI) {
+    this->held_modifiers_ &= ~(modifier | (1 << (keycode - KEY_LEFT_CTRL)));
+    return;
+  }
+  if (keycode == KEY_NONE) {
+    this->held_modifiers_ &= ~modifier;
+    return;
+  }
+  for (uint8_t i = 0; i < this->held_count_; i++) {
+    if (this->held_keys_[i] != keycode) continue;
+    for (uint8_t j = i + 1; j < this->held_count_; j++) {
+      this->held_keys_[j - 1] = this->held_keys_[j];
+      this->held_key_mods_[j - 1] = this->held_key_mods_[j];
+    }
+    this->held_count_--;
+    return;
+  }
+}
+
+void HIDKeyboard::send_held_keys_() {
+  uint8_t modifier = this->held_modifiers_;
+  for (uint8_t i = 0; i < this->held_count_; i++) modifier |= this->held_key_mods_[i];
+  this->send_report(modifier, this->held_keys_, this->held_count_);
+}
+
+void HIDKeyboard::press(const std::string &key, uint8_t modifier) {
+  uint8_t char_mod;
+  uint8_t keycode = this->resolve_key_(key, char_mod);
   ESP_LOGD(TAG, "Press: %s", key.c_str());
-  this->send_report(modifier | char_mod, keycode);
+  if (this->hold_key_(keycode, modifier | char_mod)) this->send_held_keys_();
+}
+
+void HIDKeyboard::release(const std::string &key) {
+  uint8_t char_mod;
+  uint8_t keycode = this->resolve_key_(key, char_mod);
+  ESP_LOGD(TAG, "Release: %s", key.c_str());
+  this->drop_key_(keycode, char_mod);
+  this->send_held_keys_();
 }
 
 void HIDKeyboard::release() { this->release_all(); }
 void HIDKeyboard::release_all() {
   ESP_LOGD(TAG, "Release all");
+  this->cancel_timeout("key_release");
+  this->tap_release_.clear();
+  this->held_modifiers_ = 0;
+  this->held_count_ = 0;
   this->send_report(0, 0);
 }
 
 void HIDKeyboard::tap(const std::string &key, uint8_t modifier) {
-  this->press(key, modifier);
-  delay(10);
-  this->release();
+  uint8_t char_mod;
+  uint8_t keycode = this->resolve_key_(key, char_mod);
+  ESP_LOGD(TAG, "Tap: %s", key.c_str());
+  // A key still down from an earlier tap is released first, so the host sees a
+  // second keystroke
+  for (const auto &held : this->tap_release_) {
+    if (held.first == keycode && keycode != KEY_NONE) {
+      this->release_taps_();
+      break;
+    }
+  }
+  if (!this->hold_key_(keycode, modifier | char_mod)) return;
+  this->send_held_keys_();
+  this->tap_release_.emplace_back(keycode, modifier | char_mod);
+  this->schedule_tap_release_(10);
+}
+
+void HIDKeyboard::schedule_tap_release_(uint32_t delay_ms) {
+  this->set_timeout("key_release", delay_ms, [this]() {
+    // A dropped release would leave the keys down: wait for the endpoint
+    if (tud_mounted() && !tud_hid_ready()) {
+      this->schedule_tap_release_(1);
+      return;
+    }
+    this->release_taps_();
+  });
+}
+
+void HIDKeyboard::release_taps_() {
+  this->cancel_timeout("key_release");
+  if (this->tap_release_.empty()) return;
+  for (const auto &held : this->tap_release_) this->drop_key_(held.first, held.second);
+  this->tap_release_.clear();
+  this->send_held_keys_();
+}
+
+// The whole combination goes out in one report and is released in one report
+// with the pending taps; keys that were already held stay pressed.
+void HIDKeyboard::chord(const std::vector<std::string> &keys, uint8_t modifier) {
+  // Keys of an earlier tap or chord would hide this press from the host
+  this->release_taps_();
+  uint8_t saved_modifiers = this->held_modifiers_;
+  this->held_modifiers_ |= modifier;
+  uint8_t pressed[KEYBOARD_ROLLOVER];
+  uint8_t count = 0;
+  for (const auto &key : keys) {
+    uint8_t char_mod;
+    uint8_t keycode = this->resolve_key_(key, char_mod);
+    this->held_modifiers_ |= char_mod;
+    if (keycode == KEY_NONE || (keycode >= KEY_LEFT_CTRL && keycode <= KEY_RIGHT_GUI)) {
+      this->hold_key_(keycode, 0);
+      continue;
+    }
+    bool already = false;
+    for (uint8_t i = 0; i < this->held_count_; i++) {
+      if (this->held_keys_[i] == keycode) already = true;
+    }
+    if (!already && this->hold_key_(keycode, 0)) pressed[count++] = keycode;
+  }
+  ESP_LOGD(TAG, "Chord: %d keys, mod=0x%02X", (int) keys.size(), modifier);
+  this->send_held_keys_();
+  for (uint8_t i = 0; i < count; i++) this->tap_release_.emplace_back(pressed[i], 0);
+  // Only the modifier bits the chord added are dropped with it
+  this->tap_release_.emplace_back(KEY_NONE, this->held_modifiers_ & ~saved_modifiers);
+  this->schedule_tap_release_(10);
 }
 
 void HIDKeyboard::type(const std::string &text, uint32_t speed_ms, uint32_t jitter_ms) {
   ESP_LOGI(TAG, "Type: %s (speed=%dms, jitter=%dms)", text.c_str(), speed_ms, jitter_ms);
+  // Translate the whole text before timing starts; the send loop only replays keystrokes
+  struct KeyStroke {
+    uint8_t modifier;
+    uint8_t keycode;
+  };
+  std::vector<KeyStroke> strokes;
+  strokes.reserve(text.size());
+  size_t skipped = 0;
+  char first_skipped = 0;
   for (char c : text) {
     uint8_t keycode, mod;
     this->char_to_keycode(c, keycode, mod);
-    this->send_report(mod, keycode);
-    delay(10);
-    this->send_report(0, 0);
-    
-    // Calculate delay with jitter
-    uint32_t delay_ms = speed_ms;
-    if (jitter_ms > 0) {
-      int32_t jitter = (rand() % (jitter_ms * 2 + 1)) - jitter_ms;
-      delay_ms = (int32_t)speed_ms + jitter > 10 ? speed_ms + jitter : 10;
+    if (keycode == KEY_NONE) {
+      if (skipped++ == 0) first_skipped = c;
+      continue;
     }
-    delay(delay_ms);
+    // With Caps Lock on at the host, invert Shift for letters so the text comes out as written
+    bool letter = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+    if (letter && (this->leds_ & LED_CAPS_LOCK)) mod ^= MOD_LEFT_SHIFT;
+    strokes.push_back({mod, keycode});
   }
+  if (skipped > 0) {
+    ESP_LOGW(TAG, "%u character(s) cannot be typed with this layout, first 0x%02X", (unsigned) skipped,
+             (uint8_t) first_skipped);
+  }
+
+  // The modifier stays held across a run of characters that need the same one
+  // and each key replaces the previous one in the slot; the slot is released in
+  // between only for a repeated key, and a modifier change gets its own report.
+  uint8_t held_mod = 0;
+  uint8_t held_key = KEY_NONE;
+  for (size_t i = 0; i < strokes.size(); i++) {
+    const KeyStroke &stroke = strokes[i];
+    if (stroke.modifier != held_mod || stroke.keycode == held_key) {
+      this->send_report(stroke.modifier, KEY_NONE);
+      delay(10);
+    }
+    this->send_report(stroke.modifier, stroke.keycode);
+    held_mod = stroke.modifier;
+    held_key = stroke.keycode;
+    // The delay depends on the next key as well (digraph latency)
+    uint8_t next_keycode = i + 1 < strokes.size() ? strokes[i + 1].keycode : KEY_NONE;
+    uint32_t gap = this->typing_model_.delay(this->rng_, speed_ms, jitter_ms, stroke.keycode, next_keycode);
+    if (gap > KEY_HOLD_MAX_MS) {
+      // Release the slot early so the host does not start autorepeat
+      delay(10);
+      this->send_report(held_mod, KEY_NONE);
+      held_key = KEY_NONE;
+      gap -= 10;
+    }
+    delay(gap);
+  }
+  if (held_mod != 0 || held_key != KEY_NONE) this->send_report(0, 0);
 }
 
+#if defined(HID_KEYBOARD_RUNTIME_LAYOUT) || defined(USE_HID_KEYBOARD_LAYOUT_QWERTY_US)
 // QWERTY US layout mapping
 void HIDKeyboard::char_to_keycode_qwerty(char c, uint8_t &keycode, uint8_t &modifier) {
   modifier = 0;
@@ -251,7 +522,9 @@ void HIDKeyboard::char_to_keycode_qwerty(char c, uint8_t &keycode, uint8_t &modi
     default: keycode = KEY_NONE; break;
   }
 }
+#endif
 
+#if defined(HID_KEYBOARD_RUNTIME_LAYOUT) || defined(USE_HID_KEYBOARD_LAYOUT_AZERTY_FR)
 // AZERTY FR layout mapping
 // Maps characters to the scancodes that will produce them on an AZERTY keyboard
 void HIDKeyboard::char_to_keycode_azerty(char c, uint8_t &keycode, uint8_t &modifier) {
@@ -304,7 +577,9 @@ void HIDKeyboard::char_to_keycode_azerty(char c, uint8_t &keycode, uint8_t &modi
     default: keycode = KEY_NONE; break;
   }
 }
+#endif
 
+#if defined(HID_KEYBOARD_RUNTIME_LAYOUT) || defined(USE_HID_KEYBOARD_LAYOUT_QWERTZ_DE)
 // QWERTZ DE layout mapping (German)
 void HIDKeyboard::char_to_keycode_qwertz(char c, uint8_t &keycode, uint8_t &modifier) {
   modifier = 0;
@@ -342,9 +617,17 @@ void HIDKeyboard::char_to_keycode_qwertz(char c, uint8_t &keycode, uint8_t &modi
     default: keycode = KEY_NONE; break;
   }
 }
+#endif
 
 // Main dispatcher based on layout
 void HIDKeyboard::char_to_keycode(char c, uint8_t &keycode, uint8_t &modifier) {
+#if defined(USE_HID_KEYBOARD_LAYOUT_AZERTY_FR)
+  this->char_to_keycode_azerty(c, keycode, modifier);
+#elif defined(USE_HID_KEYBOARD_LAYOUT_QWERTZ_DE)
+  this->char_to_keycode_qwertz(c, keycode, modifier);
+#elif defined(USE_HID_KEYBOARD_LAYOUT_QWERTY_US)
+  this->char_to_keycode_qwerty(c, keycode, modifier);
+#else
   switch (this->layout_) {
     case LAYOUT_AZERTY_FR:
       this->char_to_keycode_azerty(c, keycode, modifier);
@@ -357,37 +640,18 @@ void HIDKeyboard::char_to_keycode(char c, uint8_t &keycode, uint8_t &modifier) {
       this->char_to_keycode_qwerty(c, keycode, modifier);
       break;
   }
+#endif
 }
 
 uint8_t HIDKeyboard::key_name_to_keycode(const std::string &key) {
-  std::string k = key;
-  for (char &c : k) if (c >= 'a' && c <= 'z') c -= 32;
-  if (k == "ENTER" || k == "RETURN") return KEY_ENTER;
-  if (k == "ESC" || k == "ESCAPE") return KEY_ESC;
-  if (k == "BACKSPACE") return KEY_BACKSPACE;
-  if (k == "TAB") return KEY_TAB;
-  if (k == "SPACE") return KEY_SPACE;
-  if (k == "DELETE") return KEY_DELETE;
-  if (k == "INSERT") return KEY_INSERT;
-  if (k == "HOME") return KEY_HOME;
-  if (k == "END") return KEY_END;
-  if (k == "PAGEUP") return KEY_PAGE_UP;
-  if (k == "PAGEDOWN") return KEY_PAGE_DOWN;
-  if (k == "UP") return KEY_UP_ARROW;
-  if (k == "DOWN") return KEY_DOWN_ARROW;
-  if (k == "LEFT") return KEY_LEFT_ARROW;
-  if (k == "RIGHT") return KEY_RIGHT_ARROW;
-  if (k == "F1") return KEY_F1; if (k == "F2") return KEY_F2; if (k == "F3") return KEY_F3;
-  if (k == "F4") return KEY_F4; if (k == "F5") return KEY_F5; if (k == "F6") return KEY_F6;
-  if (k == "F7") return KEY_F7; if (k == "F8") return KEY_F8; if (k == "F9") return KEY_F9;
-  if (k == "F10") return KEY_F10; if (k == "F11") return KEY_F11; if (k == "F12") return KEY_F12;
-  ESP_LOGW(TAG, "Unknown key: %s", key.c_str());
-  return KEY_NONE;
+  uint8_t usage = hid_common::lookup_key_name(key.data(), key.size());
+  if (usage == KEY_NONE) ESP_LOGW(TAG, "Unknown key: %s", key.c_str());
+  return usage;
 }
 
 void HIDKeyboard::start_keep_awake(const std::string &key, uint32_t interval_ms, uint32_t jitter_ms) {
   ESP_LOGI(TAG, "Starting keep awake: key=%s, interval=%dms, jitter=%dms", key.c_str(), interval_ms, jitter_ms);
-  this->keep_awake_key_ = key;
+  this->keep_awake_keycode_ = this->resolve_key_(key, this->keep_awake_modifier_);
   this->keep_awake_interval_ = interval_ms;
   this->keep_awake_jitter_ = jitter_ms;
   this->keep_awake_last_time_ = millis();
@@ -427,15 +691,25 @@ void HIDKeyboard::loop() {}
 void HIDKeyboard::dump_config() {}
 void HIDKeyboard::press(const std::string &key, uint8_t modifier) {}
 void HIDKeyboard::release() {}
+void HIDKeyboard::release(const std::string &key) {}
+void HIDKeyboard::chord(const std::vector<std::string> &keys, uint8_t modifier) {}
+void HIDKeyboard::schedule_tap_release_(uint32_t delay_ms) {}
+void HIDKeyboard::release_taps_() {}
+uint8_t HIDKeyboard::resolve_key_(const std::string &key, uint8_t &modifier) { return 0; }
+bool HIDKeyboard::hold_key_(uint8_t keycode, uint8_t modifier) { return false; }
+void HIDKeyboard::drop_key_(uint8_t keycode, uint8_t modifier) {}
+void HIDKeyboard::send_held_keys_() {}
 void HIDKeyboard::release_all() {}
 void HIDKeyboard::tap(const std::string &key, uint8_t modifier) {}
 void HIDKeyboard::type(const std::string &text, uint32_t speed_ms, uint32_t jitter_ms) {}
+void HIDKeyboard::process_host_report(uint8_t const *buffer, uint16_t bufsize) {}
 void HIDKeyboard::char_to_keycode(char c, uint8_t &keycode, uint8_t &modifier) {}
 void HIDKeyboard::char_to_keycode_qwerty(char c, uint8_t &keycode, uint8_t &modifier) {}
 void HIDKeyboard::char_to_keycode_azerty(char c, uint8_t &keycode, uint8_t &modifier) {}
 void HIDKeyboard::char_to_keycode_qwertz(char c, uint8_t &keycode, uint8_t &modifier) {}
 uint8_t HIDKeyboard::key_name_to_keycode(const std::string &key) { return 0; }
 void HIDKeyboard::send_report(uint8_t modifier, uint8_t keycode) {}
+void HIDKeyboard::send_report(uint8_t modifier, const uint8_t *keycodes, uint8_t count) {}
 void HIDKeyboard::start_keep_awake(const std::string &key, uint32_t interval_ms, uint32_t jitter_ms) {}
 void HIDKeyboard::stop_keep_awake() {}
 bool HIDKeyboard::is_connected() { return false; }
@@ -2,16 +2,28 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/automation.h"
+#include "esphome/core/defines.h"
 #include "esphome/core/helpers.h"
+#include "esphome/components/hid_common/typing_model.h"
+#include "esphome/components/hid_common/xoshiro.h"
 
 #ifdef USE_ESP32
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #if defined(CONFIG_IDF_TARGET_ESP32S3) || defined(CONFIG_IDF_TARGET_ESP32S2)
 #define HID_KEYBOARD_SUPPORTED
 #endif
 
+// The configured layout is compiled in alone; all layouts and the per-character
+// switch are kept only with runtime_layout: true
+#if !defined(USE_HID_KEYBOARD_LAYOUT_QWERTY_US) && !defined(USE_HID_KEYBOARD_LAYOUT_AZERTY_FR) && \
+    !defined(USE_HID_KEYBOARD_LAYOUT_QWERTZ_DE)
+#define HID_KEYBOARD_RUNTIME_LAYOUT
+#endif
+
 namespace esphome {
 namespace hid_keyboard {
 
@@ -35,6 +47,24 @@ enum Modifier : uint8_t {
   MOD_RIGHT_GUI = 0x80,
 };
 
+// Keyboard LED bits in the host output report
+enum KeyboardLed : uint8_t {
+  LED_NUM_LOCK = 0x01,
+  LED_CAPS_LOCK = 0x02,
+  LED_SCROLL_LOCK = 0x04,
+};
+
+// Non-modifier keys that can be held at once
+#ifdef USE_HID_KEYBOARD_NKRO
+static const uint8_t KEYBOARD_ROLLOVER = 16;
+#else
+static const uint8_t KEYBOARD_ROLLOVER = 6;
+#endif
+
+// A typed key stays down until the next character; past this the key slot is
+// released early so the host does not start autorepeat
+static const uint32_t KEY_HOLD_MAX_MS = 200;
+
 class HIDKeyboard : public Component {
  public:
   void setup() override;
@@ -42,10 +72,13 @@ class HIDKeyboard : public Component {
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
 
+  // Keys are added to / removed from the pressed-key set
   void press(const std::string &key, uint8_t modifier = MOD_NONE);
   void release();
+  void release(const std::string &key);
   void release_all();
   void tap(const std::string &key, uint8_t modifier = MOD_NONE);
+  void chord(const std::vector<std::string> &keys, uint8_t modifier = MOD_NONE);
   void type(const std::string &text, uint32_t speed_ms = 50, uint32_t jitter_ms = 0);
   
   // Layout
@@ -62,6 +95,11 @@ class HIDKeyboard : public Component {
 
   bool is_initialized() const { return this->initialized_; }
 
+  // Host keyboard LED state (Num/Caps/Scroll Lock)
+  uint8_t get_leds() const { return this->leds_; }
+  void add_on_leds_callback(std::function<void(uint8_t)> &&callback) { this->leds_callbacks_.add(std::move(callback)); }
+  void process_host_report(uint8_t const *buffer, uint16_t bufsize);
+
  protected:
   bool initialized_{false};
   KeyboardLayout layout_{LAYOUT_QWERTY_US};
@@ -71,10 +109,36 @@ class HIDKeyboard : public Component {
   void char_to_keycode_qwertz(char c, uint8_t &keycode, uint8_t &modifier);
   uint8_t key_name_to_keycode(const std::string &key);
   void send_report(uint8_t modifier, uint8_t keycode);
+  void send_report(uint8_t modifier, const uint8_t *keycodes, uint8_t count);
+  uint8_t resolve_key_(const std::string &key, uint8_t &modifier);
+
+  hid_common::Xoshiro128 rng_;
+  hid_common::TypingModel typing_model_;
+
+  // Host LEDs (written from the USB task, published from loop())
+  volatile uint8_t leds_{0};
+  uint8_t leds_published_{0};
+  CallbackManager<void(uint8_t)> leds_callbacks_;
+
+  // Pressed-key set
+  uint8_t held_modifiers_{0};
+  uint8_t held_keys_[KEYBOARD_ROLLOVER]{};
+  uint8_t held_key_mods_[KEYBOARD_ROLLOVER]{};
+  uint8_t held_count_{0};
+  bool hold_key_(uint8_t keycode, uint8_t modifier);
+  void drop_key_(uint8_t keycode, uint8_t modifier);
+  void send_held_keys_();
+
+  // Keys pressed by taps and chords, as (keycode, modifier), released together
+  // by the "key_release" timeout instead of blocking the loop
+  std::vector<std::pair<uint8_t, uint8_t>> tap_release_;
+  void schedule_tap_release_(uint32_t delay_ms);
+  void release_taps_();
   
   // Keep awake state
   bool keep_awake_enabled_{false};
-  std::string keep_awake_key_;
+  uint8_t keep_awake_keycode_{0};  // resolved once in start_keep_awake()
+  uint8_t keep_awake_modifier_{0};
   uint32_t keep_awake_interval_{60000};
   uint32_t keep_awake_jitter_{0};
   uint32_t keep_awake_last_time_{0};
@@ -94,7 +158,14 @@ class PressAction : public Action<Ts...>, public Parented<HIDKeyboard> {
 template<typename... Ts>
 class ReleaseAction : public Action<Ts...>, public Parented<HIDKeyboard> {
  public:
-  void play(Ts... x) override { this->parent_->release(); }
+  TEMPLATABLE_VALUE(std::string, key)
+  void play(Ts... x) override {
+    if (this->key_.has_value()) {
+      this->parent_->release(this->key_.value(x...));
+    } else {
+      this->parent_->release();
+    }
+  }
 };
 
 template<typename... Ts>
@@ -107,6 +178,17 @@ class TapAction : public Action<Ts...>, public Parented<HIDKeyboard> {
   uint8_t modifier_{MOD_NONE};
 };
 
+template<typename... Ts>
+class ChordAction : public Action<Ts...>, public Parented<HIDKeyboard> {
+ public:
+  void set_keys(const std::vector<std::string> &keys) { this->keys_ = keys; }
+  void set_modifier(uint8_t modifier) { this->modifier_ = modifier; }
+  void play(Ts... x) override { this->parent_->chord(this->keys_, this->modifier_); }
+ protected:
+  std::vector<std::string> keys_;
+  uint8_t modifier_{MOD_NONE};
+};
+
 template<typename... Ts>
 class ReleaseAllAction : public Action<Ts...>, public Parented<HIDKeyboard> {
  public:
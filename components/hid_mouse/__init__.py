@@ -1,25 +1,41 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
+import esphome.final_validate as fv
 from esphome import automation
+from esphome.components import sensor
 from esphome.const import CONF_ID
 
 CODEOWNERS = ["@AntorFR"]
 DEPENDENCIES = ["esp32"]
-AUTO_LOAD = []
+AUTO_LOAD = ["hid_common"]
 
 CONF_HID_MOUSE_ID = "hid_mouse_id"
 CONF_INTERVAL = "interval"
 CONF_JITTER = "jitter"
+CONF_DURATION = "duration"
+CONF_VELOCITY = "velocity"
+CONF_X_SENSOR = "x_sensor"
+CONF_Y_SENSOR = "y_sensor"
+CONF_MAX_SPEED = "max_speed"
+CONF_DEADZONE = "deadzone"
+CONF_EXPONENT = "exponent"
+CONF_ABSOLUTE_POINTER = "absolute_pointer"
+CONF_WIDE_REPORT = "wide_report"
+CONF_HIGH_RESOLUTION_SCROLL = "high_resolution_scroll"
 
 hid_mouse_ns = cg.esphome_ns.namespace("hid_mouse")
 HIDMouse = hid_mouse_ns.class_("HIDMouse", cg.Component)
 
 # Actions
 MoveAction = hid_mouse_ns.class_("MoveAction", automation.Action)
+MoveAbsoluteAction = hid_mouse_ns.class_("MoveAbsoluteAction", automation.Action)
 ClickAction = hid_mouse_ns.class_("ClickAction", automation.Action)
+DoubleClickAction = hid_mouse_ns.class_("DoubleClickAction", automation.Action)
+DragAction = hid_mouse_ns.class_("DragAction", automation.Action)
 PressAction = hid_mouse_ns.class_("PressAction", automation.Action)
 ReleaseAction = hid_mouse_ns.class_("ReleaseAction", automation.Action)
 ScrollAction = hid_mouse_ns.class_("ScrollAction", automation.Action)
+SetVelocityAction = hid_mouse_ns.class_("SetVelocityAction", automation.Action)
 StartKeepAwakeAction = hid_mouse_ns.class_("StartKeepAwakeAction", automation.Action)
 StopKeepAwakeAction = hid_mouse_ns.class_("StopKeepAwakeAction", automation.Action)
 
@@ -34,6 +50,28 @@ MOUSE_BUTTONS = {
 CONFIG_SCHEMA = cv.Schema(
     {
         cv.GenerateID(): cv.declare_id(HIDMouse),
+        # 16-bit X/Y/wheel in the report instead of 8-bit (not boot protocol compatible)
+        cv.Optional(CONF_WIDE_REPORT, default=False): cv.boolean,
+        # Resolution Multiplier feature report for the wheel
+        cv.Optional(CONF_HIGH_RESOLUTION_SCROLL, default=False): cv.boolean,
+        # Second pointer collection with absolute X/Y, for hid_mouse.move_absolute
+        cv.Optional(CONF_ABSOLUTE_POINTER, default=False): cv.boolean,
+        # Sensors (-1 to 1, e.g. a joystick axis) driving the pointer velocity
+        cv.Optional(CONF_VELOCITY): cv.All(
+            cv.Schema(
+                {
+                    cv.Optional(CONF_X_SENSOR): cv.use_id(sensor.Sensor),
+                    cv.Optional(CONF_Y_SENSOR): cv.use_id(sensor.Sensor),
+                    # Counts per second at full deflection
+                    cv.Optional(CONF_MAX_SPEED, default=1000): cv.float_range(min=1, max=100000),
+                    # Deflection ignored around the center
+                    cv.Optional(CONF_DEADZONE, default=0.05): cv.float_range(min=0, max=0.9),
+                    # Response curve: 1 is linear, higher gives finer control near the center
+                    cv.Optional(CONF_EXPONENT, default=2.0): cv.float_range(min=1, max=5),
+                }
+            ),
+            cv.has_at_least_one_key(CONF_X_SENSOR, CONF_Y_SENSOR),
+        ),
     }
 ).extend(cv.COMPONENT_SCHEMA)
 
@@ -41,14 +79,53 @@ CONFIG_SCHEMA = cv.Schema(
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
+    if config[CONF_WIDE_REPORT]:
+        cg.add_define("USE_HID_MOUSE_WIDE_REPORT")
+    if config[CONF_HIGH_RESOLUTION_SCROLL]:
+        cg.add_define("USE_HID_MOUSE_HIRES_SCROLL")
+    if config[CONF_ABSOLUTE_POINTER]:
+        cg.add_define("USE_HID_MOUSE_ABSOLUTE_POINTER")
+    if CONF_VELOCITY in config:
+        velocity = config[CONF_VELOCITY]
+        cg.add_define("USE_HID_MOUSE_VELOCITY_SENSORS")
+        cg.add(var.set_velocity_curve(velocity[CONF_MAX_SPEED], velocity[CONF_DEADZONE], velocity[CONF_EXPONENT]))
+        if CONF_X_SENSOR in velocity:
+            sens = await cg.get_variable(velocity[CONF_X_SENSOR])
+            cg.add(var.set_velocity_x_sensor(sens))
+        if CONF_Y_SENSOR in velocity:
+            sens = await cg.get_variable(velocity[CONF_Y_SENSOR])
+            cg.add(var.set_velocity_y_sensor(sens))
+
+
+def iter_actions(value, name):
+    if isinstance(value, dict):
+        for key, item in value.items():
+            if key == name:
+                yield item
+            else:
+                yield from iter_actions(item, name)
+    elif isinstance(value, list):
+        for item in value:
+            yield from iter_actions(item, name)
+
+
+# Actions are validated before the hid_mouse block is, so the checks that
+# depend on its options run here
+def final_validate(config):
+    full_config = fv.full_config.get()
+    if not config[CONF_ABSOLUTE_POINTER] and any(iter_actions(full_config, "hid_mouse.move_absolute")):
+        raise cv.Invalid("hid_mouse.move_absolute needs absolute_pointer: true")
+
+
+FINAL_VALIDATE_SCHEMA = final_validate
 
 
 # Action: Move
 MOVE_ACTION_SCHEMA = cv.Schema(
     {
         cv.GenerateID(): cv.use_id(HIDMouse),
-        cv.Required("x"): cv.templatable(cv.int_),
-        cv.Required("y"): cv.templatable(cv.int_),
+        cv.Required("x"): cv.templatable(cv.int_range(min=-32767, max=32767)),
+        cv.Required("y"): cv.templatable(cv.int_range(min=-32767, max=32767)),
     }
 )
 
@@ -67,6 +144,30 @@ async def hid_mouse_move_to_code(config, action_id, template_arg, args):
     return var
 
 
+# Action: Move Absolute
+MOVE_ABSOLUTE_ACTION_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.use_id(HIDMouse),
+        cv.Required("x"): cv.templatable(cv.int_range(min=0, max=32767)),
+        cv.Required("y"): cv.templatable(cv.int_range(min=0, max=32767)),
+    }
+)
+
+
+@automation.register_action("hid_mouse.move_absolute", MoveAbsoluteAction, MOVE_ABSOLUTE_ACTION_SCHEMA)
+async def hid_mouse_move_absolute_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    
+    template_ = await cg.templatable(config["x"], args, cg.uint16)
+    cg.add(var.set_x(template_))
+    
+    template_ = await cg.templatable(config["y"], args, cg.uint16)
+    cg.add(var.set_y(template_))
+    
+    return var
+
+
 # Action: Click
 CLICK_ACTION_SCHEMA = cv.Schema(
     {
@@ -84,6 +185,59 @@ async def hid_mouse_click_to_code(config, action_id, template_arg, args):
     return var
 
 
+# Action: Double Click
+DOUBLE_CLICK_ACTION_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.use_id(HIDMouse),
+        cv.Optional("button", default="LEFT"): cv.enum(MOUSE_BUTTONS, upper=True),
+        # Gap between the first release and the second press
+        cv.Optional(CONF_INTERVAL, default="100ms"): cv.templatable(cv.positive_time_period_milliseconds),
+    }
+)
+
+
+@automation.register_action("hid_mouse.double_click", DoubleClickAction, DOUBLE_CLICK_ACTION_SCHEMA)
+async def hid_mouse_double_click_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    cg.add(var.set_button(config["button"]))
+    
+    template_ = await cg.templatable(config[CONF_INTERVAL], args, cg.uint32)
+    cg.add(var.set_interval(template_))
+    
+    return var
+
+
+# Action: Drag
+DRAG_ACTION_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.use_id(HIDMouse),
+        cv.Optional("button", default="LEFT"): cv.enum(MOUSE_BUTTONS, upper=True),
+        cv.Required("x"): cv.templatable(cv.int_range(min=-32767, max=32767)),
+        cv.Required("y"): cv.templatable(cv.int_range(min=-32767, max=32767)),
+        cv.Optional(CONF_DURATION, default="500ms"): cv.templatable(cv.positive_time_period_milliseconds),
+    }
+)
+
+
+@automation.register_action("hid_mouse.drag", DragAction, DRAG_ACTION_SCHEMA)
+async def hid_mouse_drag_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    cg.add(var.set_button(config["button"]))
+    
+    template_ = await cg.templatable(config["x"], args, cg.int32)
+    cg.add(var.set_x(template_))
+    
+    template_ = await cg.templatable(config["y"], args, cg.int32)
+    cg.add(var.set_y(template_))
+    
+    template_ = await cg.templatable(config[CONF_DURATION], args, cg.uint32)
+    cg.add(var.set_duration(template_))
+    
+    return var
+
+
 # Action: Press
 PRESS_ACTION_SCHEMA = cv.Schema(
     {
@@ -122,7 +276,8 @@ async def hid_mouse_release_to_code(config, action_id, template_arg, args):
 SCROLL_ACTION_SCHEMA = cv.Schema(
     {
         cv.GenerateID(): cv.use_id(HIDMouse),
-        cv.Required("amount"): cv.templatable(cv.int_),
+        # Detents; fractions accumulate
+        cv.Required("amount"): cv.templatable(cv.float_range(min=-1000, max=1000)),
     }
 )
 
@@ -132,12 +287,37 @@ async def hid_mouse_scroll_to_code(config, action_id, template_arg, args):
     var = cg.new_Pvariable(action_id, template_arg)
     await cg.register_parented(var, config[CONF_ID])
     
-    template_ = await cg.templatable(config["amount"], args, cg.int_)
+    template_ = await cg.templatable(config["amount"], args, cg.float_)
     cg.add(var.set_amount(template_))
     
     return var
 
 
+# Action: Set Velocity
+SET_VELOCITY_ACTION_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.use_id(HIDMouse),
+        # Counts per second; 0, 0 stops
+        cv.Optional("x", default=0): cv.templatable(cv.float_range(min=-100000, max=100000)),
+        cv.Optional("y", default=0): cv.templatable(cv.float_range(min=-100000, max=100000)),
+    }
+)
+
+
+@automation.register_action("hid_mouse.set_velocity", SetVelocityAction, SET_VELOCITY_ACTION_SCHEMA)
+async def hid_mouse_set_velocity_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    
+    template_ = await cg.templatable(config["x"], args, cg.float_)
+    cg.add(var.set_x(template_))
+    
+    template_ = await cg.templatable(config["y"], args, cg.float_)
+    cg.add(var.set_y(template_))
+    
+    return var
+
+
 # Action: Start Keep Awake
 START_KEEP_AWAKE_ACTION_SCHEMA = cv.Schema(
     {
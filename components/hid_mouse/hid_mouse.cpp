@@ -2,6 +2,9 @@
 #include "esphome/core/log.h"
 #include "esphome/core/hal.h"
 
+#include <cmath>
+#include <vector>
+
 #ifdef USE_ESP32
 
 #ifdef HID_MOUSE_SUPPORTED
@@ -18,13 +21,38 @@ static const char *const TAG = "hid_mouse";
 // Singleton for callbacks
 static HIDMouse *g_hid_mouse_instance = nullptr;
 
-// HID Report Descriptor for Mouse (Boot protocol compatible)
+// Report IDs are only used when the absolute pointer is added; without it the
+// report stays boot protocol compatible
+#ifdef USE_HID_MOUSE_ABSOLUTE_POINTER
+static const uint8_t REPORT_ID_RELATIVE = 1;
+static const uint8_t REPORT_ID_ABSOLUTE = 2;
+#else
+static const uint8_t REPORT_ID_RELATIVE = 0;
+#endif
+
+// Logical range and size of X, Y and wheel
+#ifdef USE_HID_MOUSE_WIDE_REPORT
+#define MOUSE_DELTA_ITEMS \
+    0x16, 0x01, 0x80,  /* Logical Minimum (-32767) */ \
+    0x26, 0xFF, 0x7F,  /* Logical Maximum (32767) */ \
+    0x75, 0x10         /* Report Size (16) */
+#else
+#define MOUSE_DELTA_ITEMS \
+    0x15, 0x81,        /* Logical Minimum (-127) */ \
+    0x25, 0x7F,        /* Logical Maximum (127) */ \
+    0x75, 0x08         /* Report Size (8) */
+#endif
+
+// HID Report Descriptor for Mouse (Boot protocol compatible with 8-bit deltas)
 static const uint8_t hid_report_descriptor[] = {
     0x05, 0x01,        // Usage Page (Generic Desktop Ctrls)
     0x09, 0x02,        // Usage (Mouse)
     0xA1, 0x01,        // Collection (Application)
     0x09, 0x01,        //   Usage (Pointer)
     0xA1, 0x00,        //   Collection (Physical)
+#ifdef USE_HID_MOUSE_ABSOLUTE_POINTER
+    0x85, REPORT_ID_RELATIVE, // Report ID
+#endif
     0x05, 0x09,        //     Usage Page (Button)
     0x19, 0x01,        //     Usage Minimum (0x01)
     0x29, 0x03,        //     Usage Maximum (0x03)
@@ -39,14 +67,69 @@ static const uint8_t hid_report_descriptor[] = {
     0x05, 0x01,        //     Usage Page (Generic Desktop Ctrls)
     0x09, 0x30,        //     Usage (X)
     0x09, 0x31,        //     Usage (Y)
+#ifdef USE_HID_MOUSE_HIRES_SCROLL
+    MOUSE_DELTA_ITEMS,
+    0x95, 0x02,        //     Report Count (2)
+    0x81, 0x06,        //     Input (Data,Var,Rel)
+    // Resolution Multiplier for the wheel in the feature report; once the
+    // host sets it, one detent is SCROLL_RESOLUTION units
+    0xA1, 0x02,        //     Collection (Logical)
+    0x09, 0x48,        //       Usage (Resolution Multiplier)
+    0x15, 0x00,        //       Logical Minimum (0)
+    0x25, 0x01,        //       Logical Maximum (1)
+    0x35, 0x01,        //       Physical Minimum (1)
+    0x45, SCROLL_RESOLUTION, //  Physical Maximum (SCROLL_RESOLUTION)
+    0x75, 0x02,        //       Report Size (2)
+    0x95, 0x01,        //       Report Count (1)
+    0xB1, 0x02,        //       Feature (Data,Var,Abs)
+    0x09, 0x38,        //       Usage (Wheel)
+    0x35, 0x00,        //       Physical Minimum (0)
+    0x45, 0x00,        //       Physical Maximum (0)
+    MOUSE_DELTA_ITEMS,
+    0x95, 0x01,        //       Report Count (1)
+    0x81, 0x06,        //       Input (Data,Var,Rel)
+    0xC0,              //     End Collection
+    0x75, 0x06,        //     Report Size (6)
+    0x95, 0x01,        //     Report Count (1)
+    0xB1, 0x03,        //     Feature (Const,Var,Abs) - padding
+#else
     0x09, 0x38,        //     Usage (Wheel)
-    0x15, 0x81,        //     Logical Minimum (-127)
-    0x25, 0x7F,        //     Logical Maximum (127)
-    0x75, 0x08,        //     Report Size (8)
+    MOUSE_DELTA_ITEMS,
     0x95, 0x03,        //     Report Count (3)
     0x81, 0x06,        //     Input (Data,Var,Rel)
+#endif
+    0xC0,              //   End Collection
+    0xC0,              // End Collection
+#ifdef USE_HID_MOUSE_ABSOLUTE_POINTER
+    // Absolute pointer: X/Y are positions on the screen
+    0x05, 0x01,        // Usage Page (Generic Desktop Ctrls)
+    0x09, 0x02,        // Usage (Mouse)
+    0xA1, 0x01,        // Collection (Application)
+    0x09, 0x01,        //   Usage (Pointer)
+    0xA1, 0x00,        //   Collection (Physical)
+    0x85, REPORT_ID_ABSOLUTE, // Report ID
+    0x05, 0x09,        //     Usage Page (Button)
+    0x19, 0x01,        //     Usage Minimum (0x01)
+    0x29, 0x03,        //     Usage Maximum (0x03)
+    0x15, 0x00,        //     Logical Minimum (0)
+    0x25, 0x01,        //     Logical Maximum (1)
+    0x95, 0x03,        //     Report Count (3)
+    0x75, 0x01,        //     Report Size (1)
+    0x81, 0x02,        //     Input (Data,Var,Abs)
+    0x95, 0x01,        //     Report Count (1)
+    0x75, 0x05,        //     Report Size (5)
+    0x81, 0x03,        //     Input (Const,Var,Abs) - padding
+    0x05, 0x01,        //     Usage Page (Generic Desktop Ctrls)
+    0x09, 0x30,        //     Usage (X)
+    0x09, 0x31,        //     Usage (Y)
+    0x15, 0x00,        //     Logical Minimum (0)
+    0x26, 0xFF, 0x7F,  //     Logical Maximum (32767)
+    0x75, 0x10,        //     Report Size (16)
+    0x95, 0x02,        //     Report Count (2)
+    0x81, 0x02,        //     Input (Data,Var,Abs)
     0xC0,              //   End Collection
     0xC0,              // End Collection
+#endif
 };
 
 // USB Device Descriptor
@@ -98,6 +181,14 @@ uint16_t tud_hid_get_report_cb(uint8_t instance, uint8_t report_id,
                                 hid_report_type_t report_type, uint8_t *buffer,
                                 uint16_t reqlen) {
   (void)instance;
+#ifdef USE_HID_MOUSE_HIRES_SCROLL
+  // Feature report: wheel resolution multiplier in bits 0-1
+  if (report_type == HID_REPORT_TYPE_FEATURE && report_id == REPORT_ID_RELATIVE &&
+      reqlen >= 1 && g_hid_mouse_instance != nullptr) {
+    buffer[0] = g_hid_mouse_instance->is_high_resolution_requested() ? 0x01 : 0x00;
+    return 1;
+  }
+#endif
   (void)report_id;
   (void)report_type;
   (void)buffer;
@@ -109,6 +200,12 @@ void tud_hid_set_report_cb(uint8_t instance, uint8_t report_id,
                            hid_report_type_t report_type, uint8_t const *buffer,
                            uint16_t bufsize) {
   (void)instance;
+#ifdef USE_HID_MOUSE_HIRES_SCROLL
+  if (report_type == HID_REPORT_TYPE_FEATURE && report_id == REPORT_ID_RELATIVE &&
+      bufsize >= 1 && g_hid_mouse_instance != nullptr) {
+    g_hid_mouse_instance->request_high_resolution_scroll((buffer[0] & 0x03) != 0);
+  }
+#endif
   (void)report_id;
   (void)report_type;
   (void)buffer;
@@ -162,27 +259,54 @@ void HIDMouse::loop() {
     return;
   }
 
+  // Resolution multiplier changes arrive on the USB task; apply them before scrolling
+  this->set_high_resolution_scroll(this->high_resolution_requested_);
+
   // Send pending report if device is ready
   if (this->report_pending_ && tud_mounted() && tud_hid_ready()) {
     this->send_report_();
   }
   
-  // Handle keep awake
-  if (this->keep_awake_enabled_) {
+  // Undo the keep-awake jiggle in the frame right after it
+  if ((this->keep_awake_return_x_ != 0 || this->keep_awake_return_y_ != 0) && !this->report_pending_ &&
+      tud_mounted() && tud_hid_ready()) {
+    bool absolute = this->absolute_;
+    this->x_ = this->keep_awake_return_x_;
+    this->y_ = this->keep_awake_return_y_;
+    this->keep_awake_return_x_ = 0;
+    this->keep_awake_return_y_ = 0;
+    this->send_report_();
+    this->absolute_ = absolute;
+  }
+
+  this->process_gesture_();
+  this->process_velocity_();
+
+  // Handle keep awake; a running gesture or velocity motion already keeps the host awake
+  if (this->keep_awake_enabled_ && this->gesture_count_ == 0 && this->velocity_x_ == 0 && this->velocity_y_ == 0) {
     uint32_t now = millis();
-    if (now - this->keep_awake_last_time_ >= this->keep_awake_next_interval_) {
+    // Only jiggle on an idle endpoint so the move goes out now and its inverse
+    // in the next frame, leaving the pointer where it was
+    if (now - this->keep_awake_last_time_ >= this->keep_awake_next_interval_ && !this->report_pending_ &&
+        this->keep_awake_return_x_ == 0 && this->keep_awake_return_y_ == 0 && tud_mounted() && tud_hid_ready()) {
       // Generate random movement (-1 to 1)
-      int8_t dx = (rand() % 3) - 1;
-      int8_t dy = (rand() % 3) - 1;
+      int8_t dx = (int8_t) this->rng_.below(3) - 1;
+      int8_t dy = (int8_t) this->rng_.below(3) - 1;
       if (dx == 0 && dy == 0) dx = 1;  // Ensure at least some movement
       
-      this->move(dx, dy);
-      ESP_LOGD(TAG, "Keep awake: move(%d, %d)", dx, dy);
+      bool absolute = this->absolute_;
+      this->x_ = dx;
+      this->y_ = dy;
+      this->send_report_();
+      this->absolute_ = absolute;
+      this->keep_awake_return_x_ = -dx;
+      this->keep_awake_return_y_ = -dy;
+      ESP_LOGD(TAG, "Keep awake: jiggle(%d, %d)", dx, dy);
       
       // Calculate next interval with jitter
       this->keep_awake_next_interval_ = this->keep_awake_interval_;
       if (this->keep_awake_jitter_ > 0) {
-        int32_t jitter = (rand() % (this->keep_awake_jitter_ * 2 + 1)) - this->keep_awake_jitter_;
+        int32_t jitter = this->rng_.symmetric(this->keep_awake_jitter_);
         this->keep_awake_next_interval_ = (int32_t)this->keep_awake_interval_ + jitter > 1000 
                                           ? this->keep_awake_interval_ + jitter : 1000;
       }
@@ -194,6 +318,16 @@ void HIDMouse::loop() {
 void HIDMouse::dump_config() {
   ESP_LOGCONFIG(TAG, "HID Mouse:");
   ESP_LOGCONFIG(TAG, "  Status: %s", this->initialized_ ? "Initialized" : "Not initialized");
+#ifdef USE_HID_MOUSE_HIRES_SCROLL
+  ESP_LOGCONFIG(TAG, "  High-resolution scroll: %u units per detent", SCROLL_RESOLUTION);
+#endif
+#ifdef USE_HID_MOUSE_ABSOLUTE_POINTER
+  ESP_LOGCONFIG(TAG, "  Absolute pointer: 0-%u", (unsigned) ABSOLUTE_MAX);
+#endif
+}
+
+static int16_t clamp_delta(int32_t delta) {
+  return delta > MOUSE_DELTA_MAX ? MOUSE_DELTA_MAX : (delta < -MOUSE_DELTA_MAX ? -MOUSE_DELTA_MAX : delta);
 }
 
 void HIDMouse::send_report_() {
@@ -201,16 +335,53 @@ void HIDMouse::send_report_() {
     return;
   }
 
+#ifdef USE_HID_MOUSE_ABSOLUTE_POINTER
+  // Buttons follow the pointer that moved last, so presses around a
+  // move_absolute drag on the absolute pointer
+  if (this->absolute_ && this->x_ == 0 && this->y_ == 0 && this->wheel_pending_ == 0) {
+    uint8_t report[5] = {
+      this->buttons_,
+      (uint8_t)(this->absolute_x_ & 0xFF),
+      (uint8_t)(this->absolute_x_ >> 8),
+      (uint8_t)(this->absolute_y_ & 0xFF),
+      (uint8_t)(this->absolute_y_ >> 8)
+    };
+
+    if (tud_hid_report(REPORT_ID_ABSOLUTE, report, sizeof(report))) {
+      ESP_LOGD(TAG, "Report sent: buttons=%02X absolute x=%u y=%u",
+               this->buttons_, this->absolute_x_, this->absolute_y_);
+    } else {
+      ESP_LOGW(TAG, "Failed to send HID report");
+    }
+    this->report_pending_ = false;
+    return;
+  }
+#endif
+
+  // Wheel units beyond one report stay pending for the next frame
+  int16_t wheel = clamp_delta(this->wheel_pending_);
+
+#ifdef USE_HID_MOUSE_WIDE_REPORT
+  uint8_t report[7] = {
+    this->buttons_,
+    (uint8_t)(this->x_ & 0xFF), (uint8_t)((uint16_t)this->x_ >> 8),
+    (uint8_t)(this->y_ & 0xFF), (uint8_t)((uint16_t)this->y_ >> 8),
+    (uint8_t)(wheel & 0xFF), (uint8_t)((uint16_t)wheel >> 8)
+  };
+#else
   uint8_t report[4] = {
     this->buttons_,
     (uint8_t)this->x_,
     (uint8_t)this->y_,
-    (uint8_t)this->wheel_
+    (uint8_t)wheel
   };
+#endif
 
-  if (tud_hid_report(0, report, sizeof(report))) {
+  if (tud_hid_report(REPORT_ID_RELATIVE, report, sizeof(report))) {
     ESP_LOGD(TAG, "Report sent: buttons=%02X x=%d y=%d wheel=%d", 
-             this->buttons_, this->x_, this->y_, this->wheel_);
+             this->buttons_, this->x_, this->y_, wheel);
+    if (this->x_ != 0 || this->y_ != 0) this->absolute_ = false;
+    this->wheel_pending_ -= wheel;
   } else {
     ESP_LOGW(TAG, "Failed to send HID report");
   }
@@ -218,14 +389,13 @@ void HIDMouse::send_report_() {
   // Clear movement values after sending
   this->x_ = 0;
   this->y_ = 0;
-  this->wheel_ = 0;
-  this->report_pending_ = false;
+  this->report_pending_ = this->wheel_pending_ != 0;
 }
 
-void HIDMouse::move(int8_t x, int8_t y) {
+void HIDMouse::move(int16_t x, int16_t y) {
   ESP_LOGD(TAG, "Move: x=%d y=%d", x, y);
-  this->x_ = x;
-  this->y_ = y;
+  this->x_ = clamp_delta(x);
+  this->y_ = clamp_delta(y);
   this->report_pending_ = true;
   
   // Try to send immediately if ready
@@ -234,11 +404,141 @@ void HIDMouse::move(int8_t x, int8_t y) {
   }
 }
 
-void HIDMouse::click(MouseButton button) {
+void HIDMouse::move_absolute(uint16_t x, uint16_t y) {
+#ifdef USE_HID_MOUSE_ABSOLUTE_POINTER
+  ESP_LOGD(TAG, "Move absolute: x=%u y=%u", x, y);
+  this->absolute_x_ = x > ABSOLUTE_MAX ? ABSOLUTE_MAX : x;
+  this->absolute_y_ = y > ABSOLUTE_MAX ? ABSOLUTE_MAX : y;
+  this->absolute_ = true;
+  // The absolute position replaces a relative move still waiting to be sent
+  this->x_ = 0;
+  this->y_ = 0;
+  this->wheel_pending_ = 0;
+  this->report_pending_ = true;
+
+  if (this->initialized_ && tud_mounted() && tud_hid_ready()) {
+    this->send_report_();
+  }
+#else
+  ESP_LOGW(TAG, "move_absolute needs absolute_pointer: true");
+#endif
+}
+
+// Gestures are queued whole, so the steps of one gesture are never interleaved
+// with another gesture or a keep-awake jiggle. Steps only go out on an idle
+// endpoint, and a hold is timed from the report that starts it.
+void HIDMouse::click(MouseButton button, std::function<void()> &&on_done) {
   ESP_LOGD(TAG, "Click: button=%d", button);
-  this->press(button);
-  delay(50);
-  this->release(button);
+  this->queue_gesture_({{button, 0, 0, 0, CLICK_HOLD_MS}, {0, button, 0, 0, 0}}, std::move(on_done));
+}
+
+void HIDMouse::double_click(MouseButton button, uint32_t interval_ms, std::function<void()> &&on_done) {
+  ESP_LOGD(TAG, "Double click: button=%d interval=%ums", button, (unsigned) interval_ms);
+  this->queue_gesture_({{button, 0, 0, 0, CLICK_HOLD_MS},
+                        {0, button, 0, 0, interval_ms},
+                        {button, 0, 0, 0, CLICK_HOLD_MS},
+                        {0, button, 0, 0, 0}},
+                       std::move(on_done));
+}
+
+void HIDMouse::drag(MouseButton button, int32_t x, int32_t y, uint32_t duration_ms,
+                    std::function<void()> &&on_done) {
+  ESP_LOGD(TAG, "Drag: button=%d x=%d y=%d over %ums", button, (int) x, (int) y, (unsigned) duration_ms);
+  this->queue_gesture_({{button, 0, 0, 0, DRAG_HOLD_MS},
+                        {0, 0, x, y, duration_ms},
+                        {0, 0, 0, 0, DRAG_HOLD_MS},
+                        {0, button, 0, 0, 0}},
+                       std::move(on_done));
+}
+
+void HIDMouse::stop_gestures() { this->finish_gestures_(false); }
+
+void HIDMouse::queue_gesture_(std::initializer_list<GestureStep> steps, std::function<void()> &&on_done) {
+  if (this->gesture_count_ + steps.size() > GESTURE_QUEUE_SIZE) {
+    ESP_LOGW(TAG, "Gesture queue full, gesture dropped");
+    if (on_done) on_done();
+    return;
+  }
+  uint8_t index = 0;
+  for (const GestureStep &step : steps) {
+    index = (this->gesture_head_ + this->gesture_count_++) % GESTURE_QUEUE_SIZE;
+    this->gesture_steps_[index] = step;
+  }
+  this->gesture_steps_[index].on_done = std::move(on_done);
+  this->gesture_high_freq_.start();
+}
+
+void HIDMouse::process_gesture_() {
+  if (this->gesture_count_ == 0) return;
+  if (!this->is_connected()) {
+    ESP_LOGW(TAG, "Host disconnected, gestures aborted");
+    this->finish_gestures_(true);
+    return;
+  }
+  if (this->report_pending_ || !tud_hid_ready()) return;
+
+  GestureStep &step = this->gesture_steps_[this->gesture_head_];
+  if (!this->gesture_step_started_) {
+    if (step.press != 0 || step.release != 0) {
+      this->buttons_ = (this->buttons_ | step.press) & ~step.release;
+      this->gesture_buttons_ = (this->gesture_buttons_ | step.press) & ~step.release;
+      this->send_report_();
+    }
+    this->gesture_step_started_ = true;
+    this->gesture_step_start_ = millis();
+    this->gesture_sent_x_ = 0;
+    this->gesture_sent_y_ = 0;
+    return;
+  }
+
+  uint32_t elapsed = millis() - this->gesture_step_start_;
+  if (step.x != 0 || step.y != 0) {
+    // Linear motion: each frame sends what the elapsed time calls for minus
+    // what was already sent, so rounding never accumulates
+    int64_t progress = elapsed >= step.duration_ms ? 65536 : ((int64_t) elapsed << 16) / step.duration_ms;
+    int16_t dx = clamp_delta((int32_t) ((step.x * progress) >> 16) - this->gesture_sent_x_);
+    int16_t dy = clamp_delta((int32_t) ((step.y * progress) >> 16) - this->gesture_sent_y_);
+    if (dx != 0 || dy != 0) {
+      this->x_ = dx;
+      this->y_ = dy;
+      this->send_report_();
+      this->gesture_sent_x_ += dx;
+      this->gesture_sent_y_ += dy;
+    }
+    if (this->gesture_sent_x_ != step.x || this->gesture_sent_y_ != step.y) return;
+  }
+  if (elapsed < step.duration_ms) return;
+
+  auto on_done = std::move(step.on_done);
+  step.on_done = nullptr;
+  this->gesture_head_ = (this->gesture_head_ + 1) % GESTURE_QUEUE_SIZE;
+  this->gesture_count_--;
+  this->gesture_step_started_ = false;
+  if (this->gesture_count_ == 0) this->gesture_high_freq_.stop();
+  if (on_done) on_done();
+}
+
+void HIDMouse::finish_gestures_(bool notify) {
+  if (this->gesture_count_ == 0) return;
+  std::vector<std::function<void()>> callbacks;
+  while (this->gesture_count_ > 0) {
+    GestureStep &step = this->gesture_steps_[this->gesture_head_];
+    if (notify && step.on_done) callbacks.push_back(std::move(step.on_done));
+    step.on_done = nullptr;
+    this->gesture_head_ = (this->gesture_head_ + 1) % GESTURE_QUEUE_SIZE;
+    this->gesture_count_--;
+  }
+  this->gesture_step_started_ = false;
+  this->gesture_high_freq_.stop();
+  if (this->gesture_buttons_ != 0) {
+    this->buttons_ &= ~this->gesture_buttons_;
+    this->gesture_buttons_ = 0;
+    this->report_pending_ = true;
+    if (this->initialized_ && tud_mounted() && tud_hid_ready()) {
+      this->send_report_();
+    }
+  }
+  for (auto &callback : callbacks) callback();
 }
 
 void HIDMouse::press(MouseButton button) {
@@ -261,9 +561,16 @@ void HIDMouse::release(MouseButton button) {
   }
 }
 
-void HIDMouse::scroll(int8_t amount) {
-  ESP_LOGD(TAG, "Scroll: amount=%d", amount);
-  this->wheel_ = amount;
+// Counted in wheel units: one per detent, or SCROLL_RESOLUTION per detent once
+// the host has enabled the resolution multiplier. Fractions of a unit carry
+// over to the next call.
+void HIDMouse::scroll(float amount) {
+  this->wheel_remainder_ += amount * (this->high_resolution_scroll_ ? SCROLL_RESOLUTION : 1);
+  int32_t units = (int32_t) this->wheel_remainder_;
+  this->wheel_remainder_ -= units;
+  ESP_LOGD(TAG, "Scroll: amount=%.2f (%d units)", amount, (int) units);
+  if (units == 0) return;
+  this->wheel_pending_ += units;
   this->report_pending_ = true;
   
   if (this->initialized_ && tud_mounted() && tud_hid_ready()) {
@@ -271,6 +578,80 @@ void HIDMouse::scroll(int8_t amount) {
   }
 }
 
+void HIDMouse::set_velocity(float vx, float vy) {
+  if (std::isnan(vx)) vx = 0;
+  if (std::isnan(vy)) vy = 0;
+  bool was_moving = this->velocity_x_ != 0 || this->velocity_y_ != 0;
+  bool moving = vx != 0 || vy != 0;
+  if (moving && !was_moving) {
+    this->velocity_last_ = millis();
+    this->velocity_high_freq_.start();
+  } else if (!moving && was_moving) {
+    this->velocity_remainder_x_ = 0;
+    this->velocity_remainder_y_ = 0;
+    this->velocity_high_freq_.stop();
+  }
+  this->velocity_x_ = vx;
+  this->velocity_y_ = vy;
+  ESP_LOGV(TAG, "Velocity: x=%.1f y=%.1f counts/s", vx, vy);
+}
+
+// Each frame adds velocity * elapsed time to the remainders and sends their
+// whole counts. Motion that one report cannot carry is dropped instead of
+// piling up, so the pointer stops as soon as the velocity does.
+void HIDMouse::process_velocity_() {
+  if (this->velocity_x_ == 0 && this->velocity_y_ == 0) return;
+  if (this->report_pending_ || !tud_mounted() || !tud_hid_ready()) return;
+  uint32_t now = millis();
+  float seconds = (now - this->velocity_last_) / 1000.0f;
+  this->velocity_last_ = now;
+  if (this->gesture_count_ > 0) return;
+
+  this->velocity_remainder_x_ += this->velocity_x_ * seconds;
+  this->velocity_remainder_y_ += this->velocity_y_ * seconds;
+  int16_t dx = clamp_delta((int32_t) this->velocity_remainder_x_);
+  int16_t dy = clamp_delta((int32_t) this->velocity_remainder_y_);
+  this->velocity_remainder_x_ = fmodf(this->velocity_remainder_x_ - dx, 1.0f);
+  this->velocity_remainder_y_ = fmodf(this->velocity_remainder_y_ - dy, 1.0f);
+  if (dx == 0 && dy == 0) return;
+  this->x_ = dx;
+  this->y_ = dy;
+  this->send_report_();
+}
+
+#ifdef USE_HID_MOUSE_VELOCITY_SENSORS
+void HIDMouse::set_velocity_x_sensor(sensor::Sensor *sensor) {
+  sensor->add_on_state_callback(
+      [this](float value) { this->set_velocity(this->sensor_velocity_(value), this->velocity_y_); });
+}
+
+void HIDMouse::set_velocity_y_sensor(sensor::Sensor *sensor) {
+  sensor->add_on_state_callback(
+      [this](float value) { this->set_velocity(this->velocity_x_, this->sensor_velocity_(value)); });
+}
+
+// Deflection (-1 to 1) to counts per second: no motion inside the deadzone,
+// then the rest of the travel raised to the exponent for fine control near
+// the center
+float HIDMouse::sensor_velocity_(float value) const {
+  if (std::isnan(value)) return 0;
+  float magnitude = fminf(fabsf(value), 1.0f);
+  if (magnitude <= this->velocity_deadzone_) return 0;
+  float travel = (magnitude - this->velocity_deadzone_) / (1.0f - this->velocity_deadzone_);
+  float speed = this->velocity_max_speed_ * powf(travel, this->velocity_exponent_);
+  return value < 0 ? -speed : speed;
+}
+#endif
+
+void HIDMouse::set_high_resolution_scroll(bool enabled) {
+  if (enabled == this->high_resolution_scroll_) return;
+  ESP_LOGI(TAG, "Scroll resolution: x%u", enabled ? SCROLL_RESOLUTION : 1);
+  this->high_resolution_scroll_ = enabled;
+  // Pending units were counted at the old resolution
+  this->wheel_pending_ = 0;
+  this->wheel_remainder_ = 0;
+}
+
 void HIDMouse::start_keep_awake(uint32_t interval_ms, uint32_t jitter_ms) {
   ESP_LOGI(TAG, "Starting keep awake: interval=%dms, jitter=%dms", interval_ms, jitter_ms);
   this->keep_awake_interval_ = interval_ms;
@@ -312,11 +693,33 @@ namespace hid_mouse {
 void HIDMouse::setup() {}
 void HIDMouse::loop() {}
 void HIDMouse::dump_config() {}
-void HIDMouse::move(int8_t x, int8_t y) {}
-void HIDMouse::click(MouseButton button) {}
+void HIDMouse::move(int16_t x, int16_t y) {}
+void HIDMouse::move_absolute(uint16_t x, uint16_t y) {}
+void HIDMouse::click(MouseButton button, std::function<void()> &&on_done) {
+  if (on_done) on_done();
+}
+void HIDMouse::double_click(MouseButton button, uint32_t interval_ms, std::function<void()> &&on_done) {
+  if (on_done) on_done();
+}
+void HIDMouse::drag(MouseButton button, int32_t x, int32_t y, uint32_t duration_ms,
+                    std::function<void()> &&on_done) {
+  if (on_done) on_done();
+}
+void HIDMouse::stop_gestures() {}
+void HIDMouse::queue_gesture_(std::initializer_list<GestureStep> steps, std::function<void()> &&on_done) {}
+void HIDMouse::process_gesture_() {}
+void HIDMouse::finish_gestures_(bool notify) {}
 void HIDMouse::press(MouseButton button) {}
 void HIDMouse::release(MouseButton button) {}
-void HIDMouse::scroll(int8_t amount) {}
+void HIDMouse::scroll(float amount) {}
+void HIDMouse::set_high_resolution_scroll(bool enabled) {}
+void HIDMouse::set_velocity(float vx, float vy) {}
+void HIDMouse::process_velocity_() {}
+#ifdef USE_HID_MOUSE_VELOCITY_SENSORS
+void HIDMouse::set_velocity_x_sensor(sensor::Sensor *sensor) {}
+void HIDMouse::set_velocity_y_sensor(sensor::Sensor *sensor) {}
+float HIDMouse::sensor_velocity_(float value) const { return 0; }
+#endif
 void HIDMouse::start_keep_awake(uint32_t interval_ms, uint32_t jitter_ms) {}
 void HIDMouse::stop_keep_awake() {}
 bool HIDMouse::is_connected() { return false; }
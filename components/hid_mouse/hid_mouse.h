@@ -2,6 +2,15 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/automation.h"
+#include "esphome/core/helpers.h"
+#include "esphome/components/hid_common/xoshiro.h"
+
+#ifdef USE_HID_MOUSE_VELOCITY_SENSORS
+#include "esphome/components/sensor/sensor.h"
+#endif
+
+#include <functional>
+#include <initializer_list>
 
 #ifdef USE_ESP32
 
@@ -19,6 +28,34 @@ enum MouseButton : uint8_t {
   MOUSE_BUTTON_MIDDLE = 0x04,
 };
 
+// Largest relative motion in one report (X/Y and wheel); values beyond are clamped
+#ifdef USE_HID_MOUSE_WIDE_REPORT
+static const int16_t MOUSE_DELTA_MAX = 32767;
+#else
+static const int16_t MOUSE_DELTA_MAX = 127;
+#endif
+// Wheel units per detent when the host enables the resolution multiplier
+static const uint8_t SCROLL_RESOLUTION = 120;
+// Logical range of the absolute pointer, mapped by the host onto the whole screen
+static const uint16_t ABSOLUTE_MAX = 32767;
+
+// Gestures (click, double_click, drag) run as queued steps from loop(). A step
+// changes buttons, then moves linearly or holds for its duration before the
+// next step starts.
+struct GestureStep {
+  uint8_t press;
+  uint8_t release;
+  int32_t x;
+  int32_t y;
+  uint32_t duration_ms;
+  std::function<void()> on_done;  // set on the last step of a gesture
+};
+static const uint8_t GESTURE_QUEUE_SIZE = 16;
+// How long a click holds the button
+static const uint32_t CLICK_HOLD_MS = 50;
+// Pause after the press and before the release of a drag
+static const uint32_t DRAG_HOLD_MS = 50;
+
 class HIDMouse : public Component {
  public:
   void setup() override;
@@ -27,16 +64,46 @@ class HIDMouse : public Component {
   float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
 
   // Mouse actions
-  void move(int8_t x, int8_t y);
-  void click(MouseButton button);
+  void move(int16_t x, int16_t y);
+  void move_absolute(uint16_t x, uint16_t y);  // needs absolute_pointer: true
+  // Non-blocking gestures, queued behind the ones still running
+  void click(MouseButton button, std::function<void()> &&on_done = nullptr);
+  // interval_ms is the gap between the first release and the second press
+  void double_click(MouseButton button, uint32_t interval_ms, std::function<void()> &&on_done = nullptr);
+  // Moves by (x, y) over duration_ms with the button held
+  void drag(MouseButton button, int32_t x, int32_t y, uint32_t duration_ms,
+            std::function<void()> &&on_done = nullptr);
+  // Drops queued gestures and releases the buttons they hold
+  void stop_gestures();
+  bool is_gesture_active() const { return this->gesture_count_ > 0; }
   void press(MouseButton button);
   void release(MouseButton button);
-  void scroll(int8_t amount);
+  void scroll(float amount);  // in detents; fractions accumulate
+  // Continuous motion in counts per second, sent every poll frame with the
+  // fractions carried over; (0, 0) stops. Paused while a gesture runs.
+  void set_velocity(float vx, float vy);
+#ifdef USE_HID_MOUSE_VELOCITY_SENSORS
+  // Sensors reporting -1 to 1 drive the velocity through the deadzone and response curve
+  void set_velocity_x_sensor(sensor::Sensor *sensor);
+  void set_velocity_y_sensor(sensor::Sensor *sensor);
+  void set_velocity_curve(float max_speed, float deadzone, float exponent) {
+    this->velocity_max_speed_ = max_speed;
+    this->velocity_deadzone_ = deadzone;
+    this->velocity_exponent_ = exponent;
+  }
+#endif
   
   // Keep awake
   void start_keep_awake(uint32_t interval_ms, uint32_t jitter_ms = 0);
   void stop_keep_awake();
   
+  // Set by the host through the feature report (high_resolution_scroll). The
+  // request arrives on the USB task and loop() applies it.
+  void request_high_resolution_scroll(bool enabled) { this->high_resolution_requested_ = enabled; }
+  bool is_high_resolution_requested() const { return this->high_resolution_requested_; }
+  void set_high_resolution_scroll(bool enabled);
+  bool is_high_resolution_scroll() const { return this->high_resolution_scroll_; }
+
   // Connection status
   bool is_connected();
   bool is_ready();
@@ -45,11 +112,18 @@ class HIDMouse : public Component {
   void send_report_();
   
   uint8_t buttons_{0};
-  int8_t x_{0};
-  int8_t y_{0};
-  int8_t wheel_{0};
+  int16_t x_{0};
+  int16_t y_{0};
+  int32_t wheel_pending_{0};
+  float wheel_remainder_{0};
+  bool high_resolution_scroll_{false};
+  volatile bool high_resolution_requested_{false};
+  bool absolute_{false};
+  uint16_t absolute_x_{0};
+  uint16_t absolute_y_{0};
   bool report_pending_{false};
   bool initialized_{false};
+  hid_common::Xoshiro128 rng_;
   
   // Keep awake state
   bool keep_awake_enabled_{false};
@@ -57,6 +131,37 @@ class HIDMouse : public Component {
   uint32_t keep_awake_jitter_{0};
   uint32_t keep_awake_last_time_{0};
   uint32_t keep_awake_next_interval_{0};
+  int8_t keep_awake_return_x_{0};
+  int8_t keep_awake_return_y_{0};
+
+  // Gesture queue: a ring of steps; the head step runs once its buttons are sent
+  GestureStep gesture_steps_[GESTURE_QUEUE_SIZE];
+  uint8_t gesture_head_{0};
+  uint8_t gesture_count_{0};
+  bool gesture_step_started_{false};
+  uint32_t gesture_step_start_{0};
+  int32_t gesture_sent_x_{0};
+  int32_t gesture_sent_y_{0};
+  uint8_t gesture_buttons_{0};  // buttons currently held by gestures
+  HighFrequencyLoopRequester gesture_high_freq_;
+  void queue_gesture_(std::initializer_list<GestureStep> steps, std::function<void()> &&on_done);
+  void process_gesture_();
+  void finish_gestures_(bool notify);
+
+  // Velocity mode: counts per second and the fraction of a count not yet sent
+  float velocity_x_{0};
+  float velocity_y_{0};
+  float velocity_remainder_x_{0};
+  float velocity_remainder_y_{0};
+  uint32_t velocity_last_{0};
+  HighFrequencyLoopRequester velocity_high_freq_;
+  void process_velocity_();
+#ifdef USE_HID_MOUSE_VELOCITY_SENSORS
+  float velocity_max_speed_{1000};
+  float velocity_deadzone_{0.05f};
+  float velocity_exponent_{2.0f};
+  float sensor_velocity_(float value) const;
+#endif
 };
 
 // Action: Move
@@ -70,14 +175,66 @@ template<typename... Ts> class MoveAction : public Action<Ts...>, public Parente
   }
 };
 
-// Action: Click
+// Action: Move Absolute
+template<typename... Ts> class MoveAbsoluteAction : public Action<Ts...>, public Parented<HIDMouse> {
+ public:
+  TEMPLATABLE_VALUE(uint16_t, x)
+  TEMPLATABLE_VALUE(uint16_t, y)
+
+  void play(Ts... x) override {
+    this->parent_->move_absolute(this->x_.value(x...), this->y_.value(x...));
+  }
+};
+
+// Action: Click (runs from the component loop; the next action starts once it ends)
 template<typename... Ts> class ClickAction : public Action<Ts...>, public Parented<HIDMouse> {
  public:
   void set_button(MouseButton button) { this->button_ = button; }
 
-  void play(Ts... x) override {
-    this->parent_->click(this->button_);
+  void play_complex(Ts... x) override {
+    this->num_running_++;
+    this->parent_->click(this->button_, [this, x...]() { this->play_next_(x...); });
   }
+  void play(Ts... x) override {}
+  void stop() override { this->parent_->stop_gestures(); }
+
+ protected:
+  MouseButton button_{MOUSE_BUTTON_LEFT};
+};
+
+// Action: Double Click
+template<typename... Ts> class DoubleClickAction : public Action<Ts...>, public Parented<HIDMouse> {
+ public:
+  TEMPLATABLE_VALUE(uint32_t, interval)
+  void set_button(MouseButton button) { this->button_ = button; }
+
+  void play_complex(Ts... x) override {
+    this->num_running_++;
+    this->parent_->double_click(this->button_, this->interval_.value(x...),
+                                [this, x...]() { this->play_next_(x...); });
+  }
+  void play(Ts... x) override {}
+  void stop() override { this->parent_->stop_gestures(); }
+
+ protected:
+  MouseButton button_{MOUSE_BUTTON_LEFT};
+};
+
+// Action: Drag
+template<typename... Ts> class DragAction : public Action<Ts...>, public Parented<HIDMouse> {
+ public:
+  TEMPLATABLE_VALUE(int32_t, x)
+  TEMPLATABLE_VALUE(int32_t, y)
+  TEMPLATABLE_VALUE(uint32_t, duration)
+  void set_button(MouseButton button) { this->button_ = button; }
+
+  void play_complex(Ts... x) override {
+    this->num_running_++;
+    this->parent_->drag(this->button_, this->x_.value(x...), this->y_.value(x...), this->duration_.value(x...),
+                        [this, x...]() { this->play_next_(x...); });
+  }
+  void play(Ts... x) override {}
+  void stop() override { this->parent_->stop_gestures(); }
 
  protected:
   MouseButton button_{MOUSE_BUTTON_LEFT};
@@ -112,13 +269,24 @@ template<typename... Ts> class ReleaseAction : public Action<Ts...>, public Pare
 // Action: Scroll
 template<typename... Ts> class ScrollAction : public Action<Ts...>, public Parented<HIDMouse> {
  public:
-  TEMPLATABLE_VALUE(int, amount)
+  TEMPLATABLE_VALUE(float, amount)
 
   void play(Ts... x) override {
     this->parent_->scroll(this->amount_.value(x...));
   }
 };
 
+// Action: Set Velocity
+template<typename... Ts> class SetVelocityAction : public Action<Ts...>, public Parented<HIDMouse> {
+ public:
+  TEMPLATABLE_VALUE(float, x)
+  TEMPLATABLE_VALUE(float, y)
+
+  void play(Ts... x) override {
+    this->parent_->set_velocity(this->x_.value(x...), this->y_.value(x...));
+  }
+};
+
 // Action: Start Keep Awake
 template<typename... Ts> class StartKeepAwakeAction : public Action<Ts...>, public Parented<HIDMouse> {
  public:
@@ -0,0 +1,96 @@
+// Host benchmark: key name lookup through the generated perfect hash
+// (key_names.h) against the comparison chain it replaced.
+//
+// Build and run from the repository root:
+//   g++ -std=c++17 -O2 -o /tmp/bench_key_names scripts/bench_key_names.cpp && /tmp/bench_key_names
+//
+// The old chain only knew the names below, so both sides are timed on those
+// names, in mixed case, plus unknown names (the chain's worst case: every
+// comparison fails).
+
+#include "../components/hid_common/key_names.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using esphome::hid_common::lookup_key_name;
+
+// The key_name_to_keycode() body before the perfect hash, minus the log line
+static uint8_t comparison_chain(const std::string &key) {
+  std::string k = key;
+  for (char &c : k) if (c >= 'a' && c <= 'z') c -= 32;
+  if (k == "ENTER" || k == "RETURN") return 0x28;
+  if (k == "ESC" || k == "ESCAPE") return 0x29;
+  if (k == "BACKSPACE") return 0x2A;
+  if (k == "TAB") return 0x2B;
+  if (k == "SPACE") return 0x2C;
+  if (k == "DELETE") return 0x4C;
+  if (k == "INSERT") return 0x49;
+  if (k == "HOME") return 0x4A;
+  if (k == "END") return 0x4D;
+  if (k == "PAGEUP") return 0x4B;
+  if (k == "PAGEDOWN") return 0x4E;
+  if (k == "UP") return 0x52;
+  if (k == "DOWN") return 0x51;
+  if (k == "LEFT") return 0x50;
+  if (k == "RIGHT") return 0x4F;
+  if (k == "F1") return 0x3A;
+  if (k == "F2") return 0x3B;
+  if (k == "F3") return 0x3C;
+  if (k == "F4") return 0x3D;
+  if (k == "F5") return 0x3E;
+  if (k == "F6") return 0x3F;
+  if (k == "F7") return 0x40;
+  if (k == "F8") return 0x41;
+  if (k == "F9") return 0x42;
+  if (k == "F10") return 0x43;
+  if (k == "F11") return 0x44;
+  if (k == "F12") return 0x45;
+  return 0;
+}
+
+static const char *const NAMES[] = {
+    "ENTER", "return", "Esc", "ESCAPE", "backspace", "TAB", "space", "DELETE", "insert", "Home", "END",
+    "PageUp", "PAGEDOWN", "up", "DOWN", "Left", "RIGHT", "F1", "f2", "F3", "F4", "F5", "f6", "F7", "F8",
+    "F9", "F10", "f11", "F12",
+};
+static const char *const UNKNOWN[] = {"F13X", "NOPE", "ENTERR", "ctrl_z", "LEFT_ARROWS", "Q"};
+
+template<typename F> static double time_ns(const std::vector<std::string> &keys, F lookup, uint32_t &sink) {
+  const int rounds = 200000;
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    for (const std::string &key : keys) sink += lookup(key);
+  }
+  std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / (rounds * keys.size());
+}
+
+int main() {
+  std::vector<std::string> known(std::begin(NAMES), std::end(NAMES));
+  std::vector<std::string> unknown(std::begin(UNKNOWN), std::end(UNKNOWN));
+
+  // Both must agree on every name the chain knows
+  for (const std::string &key : known) {
+    if (lookup_key_name(key.data(), key.size()) != comparison_chain(key)) {
+      std::printf("mismatch on %s\n", key.c_str());
+      return 1;
+    }
+  }
+  for (const std::string &key : unknown) {
+    if (lookup_key_name(key.data(), key.size()) != 0) {
+      std::printf("false hit on %s\n", key.c_str());
+      return 1;
+    }
+  }
+
+  uint32_t sink = 0;
+  auto hash = [](const std::string &key) { return lookup_key_name(key.data(), key.size()); };
+  std::printf("%-10s %12s %12s\n", "names", "chain ns", "hash ns");
+  std::printf("%-10s %12.1f %12.1f\n", "known", time_ns(known, comparison_chain, sink), time_ns(known, hash, sink));
+  std::printf("%-10s %12.1f %12.1f\n", "unknown", time_ns(unknown, comparison_chain, sink),
+              time_ns(unknown, hash, sink));
+  return sink == 0;  // keeps the lookups from being optimised away
+}
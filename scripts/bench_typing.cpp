@@ -0,0 +1,145 @@
+// Host timing model: reports sent and characters per second for hid_composite.type,
+// in normal mode and in burst mode, with the component's own code.
+//
+// Build and run from the repository root (add -DUSE_HID_COMPOSITE_NKRO for the
+// bitmap report and 16-key burst groups):
+//   g++ -std=c++17 -O2 -Iscripts/host -Icomponents -DUSE_ESP32 -DUSE_HID_COMPOSITE_LAYOUT_QWERTY_US
+//       -o /tmp/bench_typing scripts/bench_typing.cpp components/hid_composite/hid_composite.cpp
+//       components/hid_common/typing_model.cpp && /tmp/bench_typing
+//
+// HIDComposite::type() runs on a virtual clock: delay() advances it and every
+// report is taken by the host model below, which turns key-down events back into
+// characters the way a host does (key slots in order, the NKRO bitmap in usage
+// order). The program exits non-zero if a text does not come out as written.
+// USB polling is not modelled, so the times are the component's own pacing.
+
+#include "hid_composite/hid_composite.h"
+#include "tinyusb.h"
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+using esphome::hid_composite::HIDComposite;
+
+static uint32_t now_ms = 0;
+
+namespace esphome {
+uint32_t millis() { return now_ms; }
+uint32_t micros() { return now_ms * 1000; }
+void delay(uint32_t ms) { now_ms += ms; }
+void delayMicroseconds(uint32_t us) {}
+}  // namespace esphome
+
+static const uint8_t REPORT_ID_KEYBOARD = 1;
+static const uint8_t MOD_SHIFT = 0x22;
+
+// Host side: key-down events from the keyboard reports, decoded with a keymap
+// learnt from the component itself
+struct Host {
+  std::map<std::pair<uint8_t, uint8_t>, char> chars;  // (shift, usage) -> character
+  std::vector<std::pair<uint8_t, uint8_t>> events;    // key-downs not decoded yet
+  std::vector<uint8_t> held;
+  std::string typed;
+  size_t reports{0};
+
+  void report(const uint8_t *report, uint16_t len) {
+    this->reports++;
+    uint8_t shift = (report[0] & MOD_SHIFT) ? 1 : 0;
+    std::vector<uint8_t> keys;
+#ifdef USE_HID_COMPOSITE_NKRO
+    for (uint16_t usage = 1; usage < (len - 1) * 8; usage++) {
+      if (report[1 + usage / 8] & (1 << (usage % 8))) keys.push_back(usage);
+    }
+#else
+    for (uint16_t i = 2; i < len; i++) {
+      if (report[i] != 0) keys.push_back(report[i]);
+    }
+#endif
+    for (uint8_t key : keys) {
+      bool down = true;
+      for (uint8_t h : this->held) down &= h != key;
+      if (!down) continue;
+      auto it = this->chars.find({shift, key});
+      if (it != this->chars.end()) {
+        this->typed += it->second;
+      } else {
+        this->events.emplace_back(shift, key);
+      }
+    }
+    this->held = keys;
+  }
+};
+
+static Host host;
+
+bool tud_mounted() { return true; }
+bool tud_suspended() { return false; }
+bool tud_hid_ready() { return true; }
+bool tud_remote_wakeup() { return true; }
+bool tud_hid_report(uint8_t report_id, const void *report, uint16_t len) {
+  if (report_id == REPORT_ID_KEYBOARD) host.report(static_cast<const uint8_t *>(report), len);
+  return true;
+}
+const char *esp_err_to_name(esp_err_t err) { return "ESP_FAIL"; }
+esp_err_t tinyusb_driver_install(const tinyusb_config_t *config) { return ESP_OK; }
+
+struct Result {
+  size_t reports;
+  uint32_t ms;
+  bool ok;
+};
+
+static Result run(HIDComposite &hid, const std::string &text, uint32_t speed, uint32_t jitter, bool burst) {
+  host.typed.clear();
+  host.reports = 0;
+  uint32_t start = now_ms;
+  hid.type(text, speed, jitter, burst);
+  return {host.reports, now_ms - start, host.typed == text};
+}
+
+int main() {
+  HIDComposite hid;
+  hid.setup();
+
+  // Each character typed on its own is one key-down: that is the host's keymap
+  std::string charset = "\n";
+  for (char c = ' '; c <= '~'; c++) charset += c;
+  for (char c : charset) {
+    host.events.clear();
+    hid.type(std::string(1, c), 0, 0, false);
+    if (host.events.size() == 1) host.chars[host.events[0]] = c;
+  }
+
+  const char *const TEXTS[][2] = {
+      {"prose", "The quick brown fox jumps over the lazy dog, then naps in the sun.\n"},
+      {"code", "for (int i = 0; i < count; i++) sum += values[i] * scale;\n"},
+      {"caps", "HELLO WORLD, THIS IS A SHOUTED LINE OF TEXT.\n"},
+      {"password", "Tr0ub4dor&3-correct_horse:Battery(staple)\n"},
+  };
+  const uint32_t SPEED_MS = 50;
+  const uint32_t JITTERS[] = {0, 20};
+
+  bool ok = true;
+  std::printf("%-9s %6s %6s | %-18s | %-18s\n", "text", "chars", "jitter", "normal  rpt  ch/s", "burst   rpt  ch/s");
+  for (const auto &entry : TEXTS) {
+    std::string text = entry[1];
+    for (uint32_t jitter : JITTERS) {
+      Result results[2] = {
+          run(hid, text, SPEED_MS, jitter, false),
+          run(hid, text, SPEED_MS, jitter, true),
+      };
+      std::printf("%-9s %6zu %6u", entry[0], text.size(), (unsigned) jitter);
+      for (const Result &r : results) {
+        std::printf(" | %12zu %5.1f%s", r.reports, text.size() * 1000.0 / r.ms, r.ok ? "" : " !");
+        ok &= r.ok;
+      }
+      std::printf("\n");
+    }
+  }
+  if (!ok) std::printf("! the host did not receive the text as written\n");
+  return ok ? 0 : 1;
+}
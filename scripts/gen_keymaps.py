@@ -0,0 +1,407 @@
+#!/usr/bin/env python3
+"""Generate the key name lookup tables for the keyboard components.
+
+The HID Keyboard/Keypad usage page (0x07) names below are the single source of
+truth. This script writes them to the hid_common component, which
+hid_composite and hid_keyboard load:
+
+- ``key_names.h``: a minimal perfect hash over all names, so the firmware
+  resolves a key name with one pass over the string, one table probe and one
+  case-insensitive compare, without allocating.
+- ``keymaps.py``: the tables the codegen uses to validate keys and resolve
+  literal keys to HID usages at compile time. The LAYOUTS tables mirror the
+  char_to_keycode_*() functions in C++ and must be kept in sync with them.
+
+Usage:
+    python3 scripts/gen_keymaps.py
+
+scripts/bench_key_names.cpp times the generated lookup on the host against the
+comparison chain it replaced.
+"""
+
+from pathlib import Path
+import sys
+
+ROOT = Path(__file__).resolve().parent.parent
+COMPONENT = "hid_common"
+
+# (usage, names...) - first name is the canonical one, the rest are aliases.
+# Single characters (letters, digits, punctuation) are not listed: they go
+# through the layout-aware char_to_keycode() path instead.
+KEY_USAGES = [
+    (0x28, "ENTER", "RETURN"),
+    (0x29, "ESC", "ESCAPE"),
+    (0x2A, "BACKSPACE", "BKSP"),
+    (0x2B, "TAB"),
+    (0x2C, "SPACE"),
+    (0x2D, "MINUS"),
+    (0x2E, "EQUAL"),
+    (0x2F, "LEFT_BRACE", "LEFT_BRACKET"),
+    (0x30, "RIGHT_BRACE", "RIGHT_BRACKET"),
+    (0x31, "BACKSLASH"),
+    (0x32, "NON_US_HASH"),
+    (0x33, "SEMICOLON"),
+    (0x34, "APOSTROPHE", "QUOTE"),
+    (0x35, "GRAVE"),
+    (0x36, "COMMA"),
+    (0x37, "PERIOD", "DOT"),
+    (0x38, "SLASH"),
+    (0x39, "CAPS_LOCK", "CAPSLOCK"),
+    *[(0x3A + i, f"F{i + 1}") for i in range(12)],
+    (0x46, "PRINT_SCREEN", "PRINTSCREEN", "PRTSC"),
+    (0x47, "SCROLL_LOCK", "SCROLLLOCK"),
+    (0x48, "PAUSE", "BREAK"),
+    (0x49, "INSERT", "INS"),
+    (0x4A, "HOME"),
+    (0x4B, "PAGEUP", "PAGE_UP", "PGUP"),
+    (0x4C, "DELETE", "DEL"),
+    (0x4D, "END"),
+    (0x4E, "PAGEDOWN", "PAGE_DOWN", "PGDN"),
+    (0x4F, "RIGHT", "RIGHT_ARROW"),
+    (0x50, "LEFT", "LEFT_ARROW"),
+    (0x51, "DOWN", "DOWN_ARROW"),
+    (0x52, "UP", "UP_ARROW"),
+    (0x53, "NUM_LOCK", "NUMLOCK"),
+    (0x54, "KP_SLASH", "KP_DIVIDE"),
+    (0x55, "KP_ASTERISK", "KP_MULTIPLY"),
+    (0x56, "KP_MINUS", "KP_SUBTRACT"),
+    (0x57, "KP_PLUS", "KP_ADD"),
+    (0x58, "KP_ENTER"),
+    *[(0x59 + i, f"KP_{i + 1}") for i in range(9)],
+    (0x62, "KP_0"),
+    (0x63, "KP_DOT", "KP_DECIMAL_POINT"),
+    (0x64, "NON_US_BACKSLASH", "INTL_BACKSLASH"),
+    (0x65, "MENU", "APPLICATION", "CONTEXT_MENU"),
+    (0x66, "POWER"),
+    (0x67, "KP_EQUAL"),
+    *[(0x68 + i, f"F{i + 13}") for i in range(12)],
+    (0x74, "EXECUTE"),
+    (0x75, "HELP"),
+    (0x76, "KEYBOARD_MENU"),
+    (0x77, "SELECT"),
+    (0x78, "STOP"),
+    (0x79, "AGAIN"),
+    (0x7A, "UNDO"),
+    (0x7B, "CUT"),
+    (0x7C, "COPY"),
+    (0x7D, "PASTE"),
+    (0x7E, "FIND"),
+    (0x7F, "MUTE"),
+    (0x80, "VOLUME_UP"),
+    (0x81, "VOLUME_DOWN"),
+    (0x82, "LOCKING_CAPS_LOCK"),
+    (0x83, "LOCKING_NUM_LOCK"),
+    (0x84, "LOCKING_SCROLL_LOCK"),
+    (0x85, "KP_COMMA"),
+    (0x86, "KP_EQUAL_SIGN"),
+    *[(0x87 + i, f"INTERNATIONAL{i + 1}") for i in range(9)],
+    *[(0x90 + i, f"LANG{i + 1}") for i in range(9)],
+    (0x99, "ALTERNATE_ERASE"),
+    (0x9A, "SYSREQ", "ATTENTION"),
+    (0x9B, "CANCEL"),
+    (0x9C, "CLEAR"),
+    (0x9D, "PRIOR"),
+    (0x9E, "RETURN2"),
+    (0x9F, "SEPARATOR"),
+    (0xA0, "OUT"),
+    (0xA1, "OPER"),
+    (0xA2, "CLEAR_AGAIN"),
+    (0xA3, "CRSEL"),
+    (0xA4, "EXSEL"),
+    (0xB0, "KP_00"),
+    (0xB1, "KP_000"),
+    (0xB2, "THOUSANDS_SEPARATOR"),
+    (0xB3, "DECIMAL_SEPARATOR"),
+    (0xB4, "CURRENCY_UNIT"),
+    (0xB5, "CURRENCY_SUBUNIT"),
+    (0xB6, "KP_LEFT_PAREN"),
+    (0xB7, "KP_RIGHT_PAREN"),
+    (0xB8, "KP_LEFT_BRACE"),
+    (0xB9, "KP_RIGHT_BRACE"),
+    (0xBA, "KP_TAB"),
+    (0xBB, "KP_BACKSPACE"),
+    *[(0xBC + i, f"KP_{c}") for i, c in enumerate("ABCDEF")],
+    (0xC2, "KP_XOR"),
+    (0xC3, "KP_CARET"),
+    (0xC4, "KP_PERCENT"),
+    (0xC5, "KP_LESS"),
+    (0xC6, "KP_GREATER"),
+    (0xC7, "KP_AMPERSAND"),
+    (0xC8, "KP_DOUBLE_AMPERSAND"),
+    (0xC9, "KP_PIPE"),
+    (0xCA, "KP_DOUBLE_PIPE"),
+    (0xCB, "KP_COLON"),
+    (0xCC, "KP_HASH"),
+    (0xCD, "KP_SPACE"),
+    (0xCE, "KP_AT"),
+    (0xCF, "KP_EXCLAMATION"),
+    (0xD0, "KP_MEM_STORE"),
+    (0xD1, "KP_MEM_RECALL"),
+    (0xD2, "KP_MEM_CLEAR"),
+    (0xD3, "KP_MEM_ADD"),
+    (0xD4, "KP_MEM_SUBTRACT"),
+    (0xD5, "KP_MEM_MULTIPLY"),
+    (0xD6, "KP_MEM_DIVIDE"),
+    (0xD7, "KP_PLUS_MINUS"),
+    (0xD8, "KP_CLEAR"),
+    (0xD9, "KP_CLEAR_ENTRY"),
+    (0xDA, "KP_BINARY"),
+    (0xDB, "KP_OCTAL"),
+    (0xDC, "KP_DECIMAL"),
+    (0xDD, "KP_HEXADECIMAL"),
+    (0xE0, "LEFT_CTRL", "LCTRL", "CTRL"),
+    (0xE1, "LEFT_SHIFT", "LSHIFT", "SHIFT"),
+    (0xE2, "LEFT_ALT", "LALT", "ALT"),
+    (0xE3, "LEFT_GUI", "LGUI", "GUI", "WIN", "CMD", "META"),
+    (0xE4, "RIGHT_CTRL", "RCTRL"),
+    (0xE5, "RIGHT_SHIFT", "RSHIFT"),
+    (0xE6, "RIGHT_ALT", "RALT", "ALTGR"),
+    (0xE7, "RIGHT_GUI", "RGUI"),
+]
+
+# Character -> (usage, shifted) tables, one per KeyboardLayout.
+KEY_A = 0x04
+KEY_1 = 0x1E
+KEY_0 = 0x27
+SHIFT = 0x02
+
+
+def _letters(swaps=None):
+    swaps = swaps or {}
+    table = {}
+    for i, c in enumerate("abcdefghijklmnopqrstuvwxyz"):
+        usage = swaps.get(c, KEY_A + i)
+        table[c] = (usage, False)
+        table[c.upper()] = (usage, True)
+    return table
+
+
+def _digits(shifted):
+    table = {str(d): (KEY_1 + d - 1, shifted) for d in range(1, 10)}
+    table["0"] = (KEY_0, shifted)
+    return table
+
+
+_COMMON = {" ": (0x2C, False), "\n": (0x28, False), "\t": (0x2B, False)}
+
+LAYOUTS = {
+    "QWERTY_US": {
+        **_letters(),
+        **_digits(False),
+        **_COMMON,
+        "-": (0x2D, False), "=": (0x2E, False), "[": (0x2F, False), "]": (0x30, False),
+        "\\": (0x31, False), ";": (0x33, False), "'": (0x34, False), "`": (0x35, False),
+        ",": (0x36, False), ".": (0x37, False), "/": (0x38, False),
+        "!": (0x1E, True), "@": (0x1F, True), "#": (0x20, True), "$": (0x21, True),
+        "%": (0x22, True), "^": (0x23, True), "&": (0x24, True), "*": (0x25, True),
+        "(": (0x26, True), ")": (0x27, True), "_": (0x2D, True), "+": (0x2E, True),
+        "{": (0x2F, True), "}": (0x30, True), "|": (0x31, True), ":": (0x33, True),
+        '"': (0x34, True), "~": (0x35, True), "<": (0x36, True), ">": (0x37, True),
+        "?": (0x38, True),
+    },
+    "AZERTY_FR": {
+        **_letters({"a": 0x14, "q": 0x04, "z": 0x1A, "w": 0x1D, "m": 0x33}),
+        **_digits(True),
+        **_COMMON,
+        "&": (0x1E, False), "-": (0x23, False), "_": (0x25, False), ".": (0x36, True),
+        ",": (0x10, False), ";": (0x36, False), ":": (0x37, False), "!": (0x38, False),
+        "?": (0x10, True), "/": (0x37, True), "*": (0x31, False), "(": (0x22, False),
+        ")": (0x2D, False), "=": (0x2E, False), "+": (0x2E, True),
+    },
+    "QWERTZ_DE": {
+        **_letters({"y": 0x1D, "z": 0x1C}),
+        **_digits(False),
+        **_COMMON,
+        "-": (0x38, False), "_": (0x38, True), ".": (0x37, False), ",": (0x36, False),
+        ";": (0x36, True), ":": (0x37, True), "?": (0x2D, True), "!": (0x1E, True),
+        "/": (0x24, True), "(": (0x25, True), ")": (0x26, True), "=": (0x27, True),
+        "+": (0x30, False), "*": (0x30, True),
+    },
+}
+
+FNV_OFFSET = 0x811C9DC5
+FNV_PRIME = 0x01000193
+MASK32 = 0xFFFFFFFF
+
+
+def key_names():
+    names = {}
+    for usage, *aliases in KEY_USAGES:
+        for name in aliases:
+            if name in names:
+                sys.exit(f"duplicate key name {name}")
+            if len(name) < 2:
+                sys.exit(f"single character key name {name} would shadow the layout path")
+            names[name] = usage
+    return names
+
+
+def name_hash(name):
+    """FNV-1a over the upper-cased name - must match key_name_hash() in C++."""
+    h = FNV_OFFSET
+    for c in name.upper().encode("ascii"):
+        h = ((h ^ c) * FNV_PRIME) & MASK32
+    return h
+
+
+def mix(h, seed):
+    """murmur3 finaliser of (hash ^ seed) - must match key_name_mix() in C++."""
+    h = (h ^ seed) & MASK32
+    h ^= h >> 16
+    h = (h * 0x85EBCA6B) & MASK32
+    h ^= h >> 13
+    h = (h * 0xC2B2AE35) & MASK32
+    h ^= h >> 16
+    return h
+
+
+def build_mph(names):
+    """Hash-and-displace: every bucket gets the first seed that drops all of
+    its names into free slots. Slot count == name count, so the hash is minimal."""
+    n = len(names)
+    n_buckets = (n + 1) // 2
+    buckets = [[] for _ in range(n_buckets)]
+    for name in names:
+        buckets[name_hash(name) % n_buckets].append(name)
+
+    seeds = [0] * n_buckets
+    slots = [None] * n
+    for b in sorted(range(n_buckets), key=lambda i: -len(buckets[i])):
+        if not buckets[b]:
+            continue
+        for seed in range(1, 0x10000):
+            wanted = [mix(name_hash(name), seed) % n for name in buckets[b]]
+            if len(set(wanted)) == len(wanted) and all(slots[s] is None for s in wanted):
+                for name, s in zip(buckets[b], wanted):
+                    slots[s] = name
+                seeds[b] = seed
+                break
+        else:
+            sys.exit(f"no seed found for bucket {b}")
+    return seeds, slots
+
+
+def render_header(namespace, names, seeds, slots):
+    blob = ""
+    entries = []
+    for name in slots:
+        entries.append((len(blob), len(name), names[name], name))
+        blob += name
+
+    out = []
+    out.append("// Generated by scripts/gen_keymaps.py - do not edit.")
+    out.append("#pragma once")
+    out.append("")
+    out.append("#include <cstddef>")
+    out.append("#include <cstdint>")
+    out.append("")
+    out.append("namespace esphome {")
+    out.append(f"namespace {namespace} {{")
+    out.append("")
+    out.append(f"// Minimal perfect hash over {len(names)} HID Keyboard usage page names.")
+    out.append(f"static const uint16_t KEY_NAME_COUNT = {len(slots)};")
+    out.append(f"static const uint16_t KEY_NAME_BUCKETS = {len(seeds)};")
+    out.append("")
+    out.append("static const uint16_t KEY_NAME_SEEDS[KEY_NAME_BUCKETS] = {")
+    for i in range(0, len(seeds), 12):
+        out.append("    " + " ".join(f"{s}," for s in seeds[i:i + 12]))
+    out.append("};")
+    out.append("")
+    out.append("static const char KEY_NAME_BLOB[] =")
+    for i in range(0, len(slots), 6):
+        out.append('    "' + "".join(slots[i:i + 6]) + '"')
+    out[-1] += ";"
+    out.append("")
+    out.append("struct KeyNameEntry {")
+    out.append("  uint16_t offset;")
+    out.append("  uint8_t length;")
+    out.append("  uint8_t usage;")
+    out.append("};")
+    out.append("")
+    out.append("static const KeyNameEntry KEY_NAME_ENTRIES[KEY_NAME_COUNT] = {")
+    for offset, length, usage, name in entries:
+        out.append(f"    {{{offset}, {length}, 0x{usage:02X}}},  // {name}")
+    out.append("};")
+    out.append("")
+    out.append("static inline uint8_t key_name_upper(char c) {")
+    out.append("  return (c >= 'a' && c <= 'z') ? c - ('a' - 'A') : c;")
+    out.append("}")
+    out.append("")
+    out.append("static inline uint32_t key_name_hash(const char *name, size_t length) {")
+    out.append(f"  uint32_t h = 0x{FNV_OFFSET:08X}u;")
+    out.append("  for (size_t i = 0; i < length; i++) {")
+    out.append("    h ^= key_name_upper(name[i]);")
+    out.append(f"    h *= 0x{FNV_PRIME:08X}u;")
+    out.append("  }")
+    out.append("  return h;")
+    out.append("}")
+    out.append("")
+    out.append("static inline uint32_t key_name_mix(uint32_t h, uint32_t seed) {")
+    out.append("  h ^= seed;")
+    out.append("  h ^= h >> 16;")
+    out.append("  h *= 0x85EBCA6Bu;")
+    out.append("  h ^= h >> 13;")
+    out.append("  h *= 0xC2B2AE35u;")
+    out.append("  h ^= h >> 16;")
+    out.append("  return h;")
+    out.append("}")
+    out.append("")
+    out.append("// Returns the HID usage for a key name (case-insensitive), or 0 if unknown.")
+    out.append("static inline uint8_t lookup_key_name(const char *name, size_t length) {")
+    out.append("  uint32_t h = key_name_hash(name, length);")
+    out.append("  const KeyNameEntry &entry =")
+    out.append("      KEY_NAME_ENTRIES[key_name_mix(h, KEY_NAME_SEEDS[h % KEY_NAME_BUCKETS]) % KEY_NAME_COUNT];")
+    out.append("  if (entry.length != length)")
+    out.append("    return 0;")
+    out.append("  const char *candidate = KEY_NAME_BLOB + entry.offset;")
+    out.append("  for (size_t i = 0; i < length; i++) {")
+    out.append("    if (key_name_upper(name[i]) != candidate[i])")
+    out.append("      return 0;")
+    out.append("  }")
+    out.append("  return entry.usage;")
+    out.append("}")
+    out.append("")
+    out.append(f"}}  // namespace {namespace}")
+    out.append("}  // namespace esphome")
+    out.append("")
+    return "\n".join(out)
+
+
+def render_python(names):
+    out = []
+    out.append("# Generated by scripts/gen_keymaps.py - do not edit.")
+    out.append("")
+    out.append("# Key name -> HID usage (Keyboard/Keypad page)")
+    out.append("KEY_NAMES = {")
+    for name, usage in names.items():
+        out.append(f'    "{name}": 0x{usage:02X},')
+    out.append("}")
+    out.append("")
+    out.append("# Layout -> character -> (HID usage, implied modifier)")
+    out.append("LAYOUT_CHARS = {")
+    for layout, table in LAYOUTS.items():
+        out.append(f'    "{layout}": {{')
+        for char, (usage, shifted) in table.items():
+            out.append(f"        {char!r}: (0x{usage:02X}, 0x{SHIFT if shifted else 0:02X}),")
+        out.append("    },")
+    out.append("}")
+    out.append("")
+    return "\n".join(out)
+
+
+def main():
+    names = key_names()
+    seeds, slots = build_mph(names)
+    for name in names:
+        h = name_hash(name)
+        assert slots[mix(h, seeds[h % len(seeds)]) % len(slots)] == name
+    path = ROOT / "components" / COMPONENT / "key_names.h"
+    path.write_text(render_header(COMPONENT, names, seeds, slots))
+    print(f"wrote {path.relative_to(ROOT)} ({len(names)} names, {len(seeds)} buckets)")
+    path = ROOT / "components" / COMPONENT / "keymaps.py"
+    path.write_text(render_python(names))
+    print(f"wrote {path.relative_to(ROOT)}")
+
+
+if __name__ == "__main__":
+    main()
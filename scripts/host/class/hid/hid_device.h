@@ -0,0 +1,16 @@
+#pragma once
+
+// Host stand-in for the TinyUSB HID class definitions the component uses.
+
+#include <cstdint>
+
+typedef enum {
+  HID_REPORT_TYPE_INVALID = 0,
+  HID_REPORT_TYPE_INPUT,
+  HID_REPORT_TYPE_OUTPUT,
+  HID_REPORT_TYPE_FEATURE,
+} hid_report_type_t;
+
+#define HID_ITF_PROTOCOL_NONE 0
+#define HID_ITF_PROTOCOL_KEYBOARD 1
+#define HID_ITF_PROTOCOL_MOUSE 2
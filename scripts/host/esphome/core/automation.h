@@ -0,0 +1,54 @@
+#pragma once
+
+// Host stand-in for the automation classes the component headers derive from.
+
+#include <functional>
+#include <tuple>
+
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+
+template<typename T, typename... X> class TemplatableValue {
+ public:
+  TemplatableValue() = default;
+  TemplatableValue(T value) : value_(value), has_value_(true) {}
+  TemplatableValue(std::function<T(X...)> f) : f_(f), has_value_(true), is_lambda_(true) {}
+  bool has_value() const { return this->has_value_; }
+  T value(X... x) { return this->is_lambda_ ? this->f_(x...) : this->value_; }
+
+ protected:
+  T value_{};
+  std::function<T(X...)> f_;
+  bool has_value_{false};
+  bool is_lambda_{false};
+};
+
+#define TEMPLATABLE_VALUE_(type, name) \
+ protected: \
+  TemplatableValue<type, Ts...> name##_{}; \
+\
+ public: \
+  template<typename V> void set_##name(V name) { this->name##_ = name; }
+#define TEMPLATABLE_VALUE(type, name) TEMPLATABLE_VALUE_(type, name)
+
+template<typename... Ts> class Action {
+ public:
+  virtual ~Action() = default;
+  virtual void play_complex(Ts... x) {
+    this->num_running_++;
+    this->play(x...);
+    this->play_next_(x...);
+  }
+  virtual void stop_complex() {}
+  virtual bool is_running() { return this->num_running_ > 0; }
+
+ protected:
+  virtual void play(Ts... x) = 0;
+  virtual void stop() {}
+  void play_next_(Ts... x) { this->num_running_--; }
+  void play_next_tuple_(const std::tuple<Ts...> &tuple) {}
+  int num_running_{0};
+};
+
+}  // namespace esphome
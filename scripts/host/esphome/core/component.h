@@ -0,0 +1,33 @@
+#pragma once
+
+// Host stand-in: the scheduler is not modelled, timeouts and intervals never fire.
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace esphome {
+
+namespace setup_priority {
+const float DATA = 600.0f;
+const float AFTER_WIFI = 250.0f;
+}  // namespace setup_priority
+
+class Component {
+ public:
+  virtual ~Component() = default;
+  virtual void setup() {}
+  virtual void loop() {}
+  virtual void dump_config() {}
+  virtual float get_setup_priority() const { return 0.0f; }
+  void mark_failed() {}
+
+ protected:
+  void set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f) {}
+  void set_timeout(uint32_t timeout, std::function<void()> &&f) {}
+  bool cancel_timeout(const std::string &name) { return true; }
+  void set_interval(const std::string &name, uint32_t interval, std::function<void()> &&f) {}
+  bool cancel_interval(const std::string &name) { return true; }
+};
+
+}  // namespace esphome
@@ -0,0 +1,3 @@
+#pragma once
+
+// Host stand-in: features are selected with -D flags on the g++ command line.
@@ -0,0 +1,14 @@
+#pragma once
+
+// Host stand-in: the benchmark defines these on its own virtual clock.
+
+#include <cstdint>
+
+namespace esphome {
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+
+}  // namespace esphome
@@ -0,0 +1,56 @@
+#pragma once
+
+// Host stand-in for the ESPHome helpers the component files use, so the
+// scripts/ benchmarks build with a plain g++ (-Iscripts/host).
+
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace esphome {
+
+// Fixed seed: the benchmarks print the same numbers on every run
+inline uint32_t random_uint32() {
+  static std::mt19937 gen(0x5EED);
+  return gen();
+}
+
+inline uint32_t fnv1_hash(const std::string &str) {
+  uint32_t hash = 2166136261UL;
+  for (char c : str) {
+    hash *= 16777619UL;
+    hash ^= (uint8_t) c;
+  }
+  return hash;
+}
+
+class HighFrequencyLoopRequester {
+ public:
+  void start() {}
+  void stop() {}
+};
+
+template<typename... X> class CallbackManager;
+template<typename... Ts> class CallbackManager<void(Ts...)> {
+ public:
+  void add(std::function<void(Ts...)> &&callback) { this->callbacks_.push_back(std::move(callback)); }
+  void call(Ts... args) {
+    for (auto &cb : this->callbacks_) cb(args...);
+  }
+
+ protected:
+  std::vector<std::function<void(Ts...)>> callbacks_;
+};
+
+template<typename T> class Parented {
+ public:
+  void set_parent(T *parent) { this->parent_ = parent; }
+  T *get_parent() const { return this->parent_; }
+
+ protected:
+  T *parent_{nullptr};
+};
+
+}  // namespace esphome
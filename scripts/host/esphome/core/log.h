@@ -0,0 +1,18 @@
+#pragma once
+
+// Host stand-in: component logging is dropped, only warnings and errors are printed.
+
+#include <cstdio>
+
+#define ESP_LOGE(tag, format, ...) std::fprintf(stderr, "[E][%s] " format "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) std::fprintf(stderr, "[W][%s] " format "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGI(tag, ...) ((void) 0)
+#define ESP_LOGD(tag, ...) ((void) 0)
+#define ESP_LOGV(tag, ...) ((void) 0)
+#define ESP_LOGVV(tag, ...) ((void) 0)
+#define ESP_LOGCONFIG(tag, ...) ((void) 0)
+#define LOG_BINARY_SENSOR(prefix, type, obj) ((void) (obj))
+#define LOG_SWITCH(prefix, type, obj) ((void) (obj))
+#define LOG_SENSOR(prefix, type, obj) ((void) (obj))
+#define YESNO(b) ((b) ? "YES" : "NO")
+#define ONOFF(b) ((b) ? "ON" : "OFF")
@@ -0,0 +1,4 @@
+#pragma once
+
+// Host stand-in: build the component as for an ESP32-S2/S3 (USB OTG).
+#define SOC_USB_OTG_SUPPORTED 1
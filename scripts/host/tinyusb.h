@@ -0,0 +1,47 @@
+#pragma once
+
+// Host stand-in for the esp_tinyusb driver API the component installs with.
+
+#include <cstdint>
+
+typedef int esp_err_t;
+#define ESP_OK 0
+const char *esp_err_to_name(esp_err_t err);
+
+#define TINYUSB_PORT_FULL_SPEED_0 0
+
+struct tusb_desc_device_t {
+  uint8_t bLength, bDescriptorType;
+  uint16_t bcdUSB;
+  uint8_t bDeviceClass, bDeviceSubClass, bDeviceProtocol, bMaxPacketSize0;
+  uint16_t idVendor, idProduct, bcdDevice;
+  uint8_t iManufacturer, iProduct, iSerialNumber, bNumConfigurations;
+};
+struct tinyusb_phy_t {
+  bool skip_setup;
+  bool self_powered;
+  int vbus_monitor_io;
+};
+struct tinyusb_task_t {
+  int size;
+  int priority;
+  int xCoreID;
+};
+struct tinyusb_desc_t {
+  const tusb_desc_device_t *device;
+  const void *qualifier;
+  const char **string;
+  int string_count;
+  const uint8_t *full_speed_config;
+  const uint8_t *high_speed_config;
+};
+struct tinyusb_config_t {
+  int port;
+  tinyusb_phy_t phy;
+  tinyusb_task_t task;
+  tinyusb_desc_t descriptor;
+  void *event_cb;
+  void *event_arg;
+};
+
+esp_err_t tinyusb_driver_install(const tinyusb_config_t *config);
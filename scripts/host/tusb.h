@@ -0,0 +1,31 @@
+#pragma once
+
+// Host stand-in for the TinyUSB device API. The descriptor macros only need to
+// compile; the benchmark defines the functions and watches the reports.
+
+#include <cstdint>
+
+#define TUSB_DESC_DEVICE 1
+#define CFG_TUD_ENDPOINT0_SIZE 64
+#define CFG_TUD_HID_EP_BUFSIZE 64
+#define TUSB_DESC_CONFIG_ATT_REMOTE_WAKEUP 0x20
+#define TUD_CONFIG_DESC_LEN 9
+#define TUD_HID_DESC_LEN 25
+#define TUD_HID_INOUT_DESC_LEN 32
+#define TUD_CONFIG_DESCRIPTOR(config_num, itf_count, str_idx, total_len, attribute, power_ma) \
+  9, 2, (uint8_t) (total_len), (uint8_t) ((total_len) >> 8), itf_count, config_num, str_idx, \
+      (uint8_t) (0x80 | (attribute)), (uint8_t) ((power_ma) / 2)
+#define TUD_HID_DESCRIPTOR(itf, str_idx, protocol, desc_len, ep_in, ep_size, interval) \
+  9, 4, itf, 0, 1, 3, (uint8_t) ((protocol) ? 1 : 0), protocol, str_idx, 9, 0x21, 0x11, 0x01, 0, 1, 0x22, \
+      (uint8_t) (desc_len), (uint8_t) ((desc_len) >> 8), 7, 5, ep_in, 3, (uint8_t) (ep_size), \
+      (uint8_t) ((ep_size) >> 8), interval
+#define TUD_HID_INOUT_DESCRIPTOR(itf, str_idx, protocol, desc_len, ep_out, ep_in, ep_size, interval) \
+  9, 4, itf, 0, 2, 3, 0, protocol, str_idx, 9, 0x21, 0x11, 0x01, 0, 1, 0x22, (uint8_t) (desc_len), \
+      (uint8_t) ((desc_len) >> 8), 7, 5, ep_out, 3, (uint8_t) (ep_size), (uint8_t) ((ep_size) >> 8), interval, 7, \
+      5, ep_in, 3, (uint8_t) (ep_size), (uint8_t) ((ep_size) >> 8), interval
+
+bool tud_mounted();
+bool tud_suspended();
+bool tud_hid_ready();
+bool tud_hid_report(uint8_t report_id, const void *report, uint16_t len);
+bool tud_remote_wakeup();
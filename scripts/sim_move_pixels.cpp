@@ -0,0 +1,163 @@
+// Host simulation of hid_composite.move_pixels: where the pointer lands on a
+// host with pointer acceleration, for a set of targets.
+//
+// Build and run from the repository root:
+//   g++ -std=c++17 -O2 -Iscripts/host -Icomponents -DUSE_ESP32 -DUSE_HID_COMPOSITE_BALLISTICS
+//       -o /tmp/sim_move_pixels scripts/sim_move_pixels.cpp components/hid_composite/hid_composite.cpp
+//       components/hid_common/typing_model.cpp && /tmp/sim_move_pixels
+//
+// HIDComposite::move_pixels() runs from loop() on a virtual clock, with the USB
+// endpoint ready once per 10 ms frame. The firmware model is the WINDOWS profile
+// at sensitivity 1 and speed_scale 1, built like BALLISTICS_PROFILES in
+// components/hid_composite/__init__.py. The simulated host applies its own curve
+// to each mouse report and keeps sub-pixel remainders. It runs three times:
+// matching the model, with 5% more sensitivity, and with a 0.9 speed scale. For
+// comparison, each target is also sent naively as its pixel count in counts, in
+// reports of at most 127 counts.
+//
+// The program exits non-zero unless, with the host matching the model, every
+// move finishes within half a pixel of its target in at most 6 reports.
+
+#include "hid_composite/hid_composite.h"
+#include "tinyusb.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+using esphome::hid_composite::HIDComposite;
+
+static uint32_t now_ms = 0;
+
+namespace esphome {
+uint32_t millis() { return now_ms; }
+uint32_t micros() { return now_ms * 1000; }
+void delay(uint32_t ms) { now_ms += ms; }
+void delayMicroseconds(uint32_t us) {}
+}  // namespace esphome
+
+static const uint8_t REPORT_ID_MOUSE = 2;
+static const float MAX_ERROR_PX = 0.5f;
+static const int MAX_REPORTS = 6;
+
+struct Curve {
+  std::vector<float> counts;
+  std::vector<float> pixels;
+
+  float to_pixels(float c) const {
+    size_t i = 1;
+    while (i + 1 < this->counts.size() && c > this->counts[i]) i++;
+    return this->pixels[i - 1] +
+           (c - this->counts[i - 1]) * (this->pixels[i] - this->pixels[i - 1]) / (this->counts[i] - this->counts[i - 1]);
+  }
+};
+
+// WINDOWS profile: SmoothMouseXCurve / SmoothMouseYCurve, one curve unit of
+// speed taken as 3.5 counts per report, one pixel per count at the slowest speed
+static Curve windows_curve(float sensitivity, float speed_scale) {
+  static const float X[] = {0.0f, 0.43f, 1.25f, 3.86f, 40.0f};
+  static const float Y[] = {0.0f, 1.37f, 5.30f, 24.30f, 568.0f};
+  Curve curve;
+  for (int i = 0; i < 5; i++) {
+    curve.counts.push_back(X[i] * 3.5f * speed_scale);
+    curve.pixels.push_back(Y[i] * 3.5f * X[1] / Y[1] * speed_scale * sensitivity);
+  }
+  return curve;
+}
+
+static float speed_magnitude(float x, float y) {
+  x = fabsf(x);
+  y = fabsf(y);
+  return x > y ? x + y / 2 : y + x / 2;
+}
+
+struct Host {
+  Curve curve;
+  double x{0};
+  double y{0};
+  int reports{0};
+
+  void report(int16_t dx, int16_t dy) {
+    this->reports++;
+    float magnitude = speed_magnitude(dx, dy);
+    if (magnitude == 0) return;
+    float gain = this->curve.to_pixels(magnitude) / magnitude;
+    this->x += dx * gain;
+    this->y += dy * gain;
+  }
+};
+
+static Host host;
+
+bool tud_mounted() { return true; }
+bool tud_suspended() { return false; }
+bool tud_hid_ready() { return now_ms % 10 == 0; }
+bool tud_remote_wakeup() { return true; }
+bool tud_hid_report(uint8_t report_id, const void *report, uint16_t len) {
+  const uint8_t *data = static_cast<const uint8_t *>(report);
+  if (report_id == REPORT_ID_MOUSE) host.report((int8_t) data[1], (int8_t) data[2]);
+  return true;
+}
+const char *esp_err_to_name(esp_err_t err) { return "ESP_FAIL"; }
+esp_err_t tinyusb_driver_install(const tinyusb_config_t *config) { return ESP_OK; }
+
+int main() {
+  static const int32_t TARGETS[][2] = {{300, 0},     {0, -300},  {1000, 250}, {-37, 12}, {5, 5},
+                                       {1920, 1080}, {-800, -3}, {64, -640},  {2, 0},    {150, 149}};
+  struct Variant {
+    const char *name;
+    float sensitivity;
+    float speed_scale;
+  };
+  static const Variant HOSTS[] = {
+      {"host = model", 1.0f, 1.0f},
+      {"host sensitivity +5%", 1.05f, 1.0f},
+      {"host speed scale 0.9", 1.0f, 0.9f},
+  };
+
+  HIDComposite hid;
+  hid.setup();
+  Curve model = windows_curve(1.0f, 1.0f);
+  for (size_t i = 0; i < model.counts.size(); i++) hid.add_ballistics_point(model.counts[i], model.pixels[i]);
+
+  bool ok = true;
+  for (const Variant &variant : HOSTS) {
+    bool checked = &variant == &HOSTS[0];
+    std::printf("%s\n", variant.name);
+    double worst = 0;
+    int most_reports = 0;
+    for (const auto &target : TARGETS) {
+      host = Host{windows_curve(variant.sensitivity, variant.speed_scale)};
+      bool done = false;
+      hid.move_pixels(target[0], target[1], [&done]() { done = true; });
+      for (int i = 0; i < 10000 && !done; i++) {
+        hid.loop();
+        now_ms++;
+      }
+      double error = fmax(fabs(host.x - target[0]), fabs(host.y - target[1]));
+      worst = fmax(worst, error);
+      most_reports = host.reports > most_reports ? host.reports : most_reports;
+
+      Host naive{windows_curve(variant.sensitivity, variant.speed_scale)};
+      int32_t nx = target[0], ny = target[1];
+      while (nx != 0 || ny != 0) {
+        int16_t sx = nx > 127 ? 127 : (nx < -127 ? -127 : nx);
+        int16_t sy = ny > 127 ? 127 : (ny < -127 ? -127 : ny);
+        naive.report(sx, sy);
+        nx -= sx;
+        ny -= sy;
+      }
+      bool failed = checked && (!done || error > MAX_ERROR_PX || host.reports > MAX_REPORTS);
+      ok &= !failed;
+      std::printf("  target %5d,%5d: landed %8.2f,%8.2f (err %5.2f,%5.2f px) in %2d reports"
+                  " | naive: %8.1f,%8.1f in %d%s\n",
+                  (int) target[0], (int) target[1], host.x, host.y, host.x - target[0], host.y - target[1],
+                  host.reports, naive.x, naive.y, naive.reports, done ? (failed ? " FAIL" : "") : " (not done)");
+    }
+    std::printf("  worst error %.2f px, at most %d reports\n", worst, most_reports);
+  }
+  if (!ok) std::printf("FAIL: with the host matching the model, moves must land within %.1f px in %d reports\n",
+                       MAX_ERROR_PX, MAX_REPORTS);
+  return ok ? 0 : 1;
+}